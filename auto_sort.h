@@ -0,0 +1,365 @@
+/*************************************************************************
+* Title: Automatic Sort Selection.
+* File: auto_sort.h
+* Date: 10/16/2026
+*
+* Sort front-end that samples its input and routes it to the kernel
+* expected to be fastest for that input (autoSort):
+*   input features from a sample (SortProfile, profileInput)
+*   selector thresholds (AutoSortTuning, autoSortTuning)
+*   kernel choice (selectKernel) and dispatch (runKernel)
+*   calibration of the thresholds on the host (calibrateAutoSort)
+*
+* Notes:
+*  (1) The profile reads at most PROFILE_SAMPLE evenly spaced keys (and
+*      their right neighbours): an estimate of the key span per element,
+*      the fraction of ascending and descending neighbour pairs, and the
+*      fraction of distinct keys in the sample.  Counting sort checks the
+*      exact key range itself, so an underestimated span costs time, not
+*      correctness.
+*  (2) Rules, in order: tiny input -> insertion sort; (nearly) sorted or
+*      reversed -> powersort; narrow integral key range -> counting sort;
+*      large input -> parallel sort; few distinct keys -> quicksort
+*      (pdqsort groups equal keys); otherwise radix sort above a size
+*      threshold and quicksort below it.
+*  (3) Default thresholds are conservative guesses.  calibrateAutoSort
+*      times the competing kernels at each decision boundary on the host
+*      with the benchmark measurement loop, and records each threshold as
+*      the feature value (size, span, sortedness, distinct fraction) of
+*      the last calibration input the favoured kernel won on.
+*  (4) Thresholds are kept per element type (autoSortTuning<T>).
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _AUTO_SORT_H_
+#define _AUTO_SORT_H_
+
+// Kernels autoSort routes to.
+enum autoKernel { AUTO_INSERTION, AUTO_COUNTING, AUTO_RADIX, AUTO_PARALLEL, AUTO_POWER, AUTO_QUICK };
+
+// Printable name of a kernel.
+inline const char* autoKernelName(autoKernel k)
+{
+	switch (k)
+	{
+		case AUTO_INSERTION: return "insertion";
+		case AUTO_COUNTING:  return "counting";
+		case AUTO_RADIX:     return "radix";
+		case AUTO_PARALLEL:  return "parallel";
+		case AUTO_POWER:     return "power";
+		case AUTO_QUICK:
+		default:             return "quick";
+	}
+}
+
+// Most keys (pairs) read by profileInput.
+constexpr std::size_t PROFILE_SAMPLE{ 1024 };
+
+// Input features estimated from a sample.
+struct SortProfile
+{
+	std::size_t n = 0;        // Number of keys.
+	double span = 0.0;        // Sampled (max - min)/n.
+	double ascending = 0.0;   // Fraction of sampled neighbour pairs a[i] <= a[i+1].
+	double descending = 0.0;  // Fraction of sampled neighbour pairs a[i] >= a[i+1].
+	double distinct = 1.0;    // Fraction of distinct keys in the sample.
+};
+
+// Selector thresholds.
+struct AutoSortTuning
+{
+	std::size_t insertionMax = 16;    // Insertion sort at or below this n.
+	std::size_t radixMin = 1024;      // Radix sort (rather than quicksort) from this n.
+	std::size_t parallelMin = std::size_t(1) << 22; // Parallel sort from this n.
+	double countingSpan = 1.0;        // Counting sort at or below this key span per element.
+	double presorted = 0.99;          // Powersort at or above this pair fraction.
+	double duplicates = 0.0;          // Quicksort at or below this distinct fraction.
+};
+
+// Selector thresholds for element type T, used by autoSort<T>.
+template <typename T>
+AutoSortTuning& autoSortTuning()
+{
+	static AutoSortTuning tuning;
+
+	return tuning;
+}
+
+/*************************************************************************
+ * Estimates the features of [begin, end) from at most PROFILE_SAMPLE
+ * evenly spaced positions.  Small inputs are sampled more sparsely (n/16
+ * keys, at least 64), keeping the profile cheap next to the sort.
+ *************************************************************************/
+template <typename T>
+SortProfile profileInput(const T* begin, const T* end)
+{
+	SortProfile p;
+	p.n = std::distance(begin, end);
+
+	if (p.n < 2)
+	{
+		p.ascending = p.descending = 1.0;
+		return p;
+	}
+
+	const std::size_t s = std::min({ PROFILE_SAMPLE, std::max<std::size_t>(64, p.n/16), p.n - 1 });
+	T sample[PROFILE_SAMPLE];
+	std::size_t up = 0, down = 0;
+	T lo = *begin, hi = *begin;
+
+	for (std::size_t i = 0; i < s; i++)
+	{
+		const T* a = begin + i*(p.n - 1)/s;
+
+		sample[i] = a[0];
+		lo = std::min(lo, a[0]);
+		hi = std::max(hi, a[0]);
+		up += !(a[1] < a[0]);
+		down += !(a[0] < a[1]);
+	}
+
+	std::sort(sample, sample + s);
+
+	p.span = (double(hi) - double(lo))/double(p.n);
+	p.ascending = double(up)/s;
+	p.descending = double(down)/s;
+	p.distinct = double(std::unique(sample, sample + s) - sample)/s;
+
+	return p;
+}
+
+// Kernel for an input with profile p, under thresholds t.
+inline autoKernel selectKernel(const SortProfile& p, const AutoSortTuning& t, bool integral)
+{
+	if (p.n <= t.insertionMax)
+		return AUTO_INSERTION;
+
+	if (p.ascending >= t.presorted || p.descending >= t.presorted)
+		return AUTO_POWER;
+
+	if (integral && p.span <= t.countingSpan)
+		return AUTO_COUNTING;
+
+	if (p.n >= t.parallelMin)
+		return AUTO_PARALLEL;
+
+	if (p.distinct <= t.duplicates)
+		return AUTO_QUICK;
+
+	return (p.n >= t.radixMin) ? AUTO_RADIX : AUTO_QUICK;
+}
+
+// Sorts [begin, end) with kernel k.
+template <typename T>
+void runKernel(autoKernel k, T* begin, T* end)
+{
+	switch (k)
+	{
+		case AUTO_INSERTION: insertionSort(begin, end); break;
+		case AUTO_RADIX:     radixSort(begin, end); break;
+		case AUTO_POWER:     powerSort(begin, end); break;
+		case AUTO_QUICK:     quickSort(begin, end); break;
+
+		case AUTO_COUNTING:
+			if constexpr (std::is_integral<T>::value)
+				countingSort(begin, end);
+			else
+				radixSort(begin, end);
+			break;
+
+		case AUTO_PARALLEL:
+#if (__cpp_lib_parallel_algorithm >= 201603 || _MSC_VER)
+			pSort(begin, end);
+#else
+			pRadix(begin, end);
+#endif
+			break;
+	}
+}
+
+// Kernel autoSort<T> would choose for [begin, end).
+template <typename T>
+autoKernel autoKernelFor(const T* begin, const T* end)
+{
+	return selectKernel(profileInput(begin, end), autoSortTuning<T>(), std::is_integral<T>::value);
+}
+
+/*************************************************************************
+ * Sorts with the kernel chosen for this input by the calibrated (or
+ * default) thresholds of type T.
+ *************************************************************************/
+template <typename T>
+void autoSort(T* begin, T* end) { runKernel(autoKernelFor(begin, end), begin, end); }
+
+/*************************************************************************
+ * Median time (ms) of one sort of input with kernel k, measured with the
+ * benchmark loop.  Small inputs are sorted in batches of copies so each
+ * trial is long enough to time.
+ *************************************************************************/
+template <typename T>
+double timeKernel(autoKernel k, const std::vector<T>& input, const BenchConfig& cfg)
+{
+	const std::size_t n = input.size();
+	const std::size_t copies = std::max<std::size_t>(1, (std::size_t(1) << 16)/std::max<std::size_t>(n, 1));
+	std::vector<T> work(n*copies);
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] {
+				for (std::size_t c = 0; c < copies; c++)
+					std::copy(input.begin(), input.end(), work.begin() + c*n);
+			},
+			[&] {
+				for (std::size_t c = 0; c < copies; c++)
+					runKernel(k, work.data() + c*n, work.data() + (c + 1)*n);
+			},
+			[&] {
+				if (!std::is_sorted(work.begin(), work.begin() + n))
+					throw std::runtime_error("sort failed");
+			},
+			counters, perf);
+	}, cfg);
+
+	return stats.median/copies;
+}
+
+// Calibration input of n uniform keys spanning about span*n values, or
+// the full (wide) key range when span is 0.
+template <typename T>
+std::vector<T> calibrationKeys(std::size_t n, double span, std::mt19937_64& rng)
+{
+	typedef typename std::conditional<std::is_floating_point<T>::value, double, long long>::type W;
+	const W hi = (span > 0.0) ? W(span*n) : std::is_floating_point<T>::value ? W(1e9) : W(std::numeric_limits<T>::max()/2);
+	uniformDistribution<W> dist(std::is_unsigned<T>::value ? W(0) : -hi/2, std::is_unsigned<T>::value ? hi : hi/2);
+	std::vector<T> v(n);
+
+	for (T& x : v)
+		x = T(dist(rng));
+
+	return v;
+}
+
+/*************************************************************************
+ * Measures the selector thresholds for type T on this host, timing the
+ * competing kernels at each decision boundary.  Sizes are capped at
+ * maxN; cfg sets the per-cell measurement effort, limited to a short
+ * budget since calibration times many cells.
+ *************************************************************************/
+template <typename T>
+AutoSortTuning calibrateAutoSort(std::size_t maxN = std::size_t(1) << 22, BenchConfig cfg = BenchConfig())
+{
+	AutoSortTuning t;
+	std::mt19937_64 rng(269);
+	const std::size_t big = std::min<std::size_t>(maxN, std::size_t(1) << 20);
+
+	cfg.report = false;
+	cfg.counters = false;
+	cfg.maxTrials = std::min(cfg.maxTrials, 20);
+	cfg.maxSeconds = std::min(cfg.maxSeconds, 0.5);
+	cfg.maxRelCI = std::max(cfg.maxRelCI, 0.05);
+
+	// Largest n insertion sort wins on.
+	t.insertionMax = 0;
+	for (std::size_t n = 4; n <= 256; n *= 2)
+	{
+		const std::vector<T> v = calibrationKeys<T>(n, 0.0, rng);
+
+		if (timeKernel(AUTO_INSERTION, v, cfg) >= timeKernel(AUTO_QUICK, v, cfg))
+			break;
+		t.insertionMax = n;
+	}
+
+	// Smallest n radix sort wins on.
+	t.radixMin = std::numeric_limits<std::size_t>::max();
+	for (std::size_t n = 64; n <= big; n *= 2)
+	{
+		const std::vector<T> v = calibrationKeys<T>(n, 0.0, rng);
+
+		if (timeKernel(AUTO_RADIX, v, cfg) < timeKernel(AUTO_QUICK, v, cfg))
+		{
+			t.radixMin = n;
+			break;
+		}
+	}
+
+	// Smallest n the parallel sort beats the sequential kernel on.
+	t.parallelMin = std::numeric_limits<std::size_t>::max();
+	for (std::size_t n = std::size_t(1) << 16; n <= maxN; n *= 4)
+	{
+		const std::vector<T> v = calibrationKeys<T>(n, 0.0, rng);
+		const autoKernel serial = (n >= t.radixMin) ? AUTO_RADIX : AUTO_QUICK;
+
+		if (timeKernel(AUTO_PARALLEL, v, cfg) < timeKernel(serial, v, cfg))
+		{
+			t.parallelMin = n;
+			break;
+		}
+	}
+
+	// Widest key span counting sort wins on (it falls back above 2n).
+	t.countingSpan = -1.0;
+	if (std::is_integral<T>::value)
+	{
+		for (double span : { 1.0/64, 1.0/8, 0.5, 1.0, 2.0 })
+		{
+			const std::vector<T> v = calibrationKeys<T>(big, span, rng);
+
+			if (timeKernel(AUTO_COUNTING, v, cfg) >= timeKernel(AUTO_RADIX, v, cfg))
+				break;
+			t.countingSpan = profileInput(v.data(), v.data() + v.size()).span;
+		}
+	}
+
+	// Least ordered input powersort wins on: sorted keys with a growing
+	// number of random swaps.
+	t.presorted = 2.0;
+	for (double swaps : { 0.0, 1e-4, 1e-3, 1e-2, 5e-2 })
+	{
+		std::vector<T> v = calibrationKeys<T>(big, 0.0, rng);
+		std::uniform_int_distribution<std::size_t> pos(0, big - 1);
+
+		std::sort(v.begin(), v.end());
+		for (std::size_t i = 0; i < std::size_t(swaps*big); i++)
+			std::swap(v[pos(rng)], v[pos(rng)]);
+
+		if (timeKernel(AUTO_POWER, v, cfg) >= timeKernel(AUTO_RADIX, v, cfg))
+			break;
+		t.presorted = profileInput(v.data(), v.data() + v.size()).ascending;
+	}
+
+	// Most distinct keys quicksort wins on: a few wide keys, repeated.
+	t.duplicates = 0.0;
+	for (std::size_t k : { 4, 32, 256 })
+	{
+		const std::vector<T> keys = calibrationKeys<T>(k, 0.0, rng);
+		std::uniform_int_distribution<std::size_t> pick(0, k - 1);
+		std::vector<T> v(big);
+
+		for (T& x : v)
+			x = keys[pick(rng)];
+
+		if (timeKernel(AUTO_QUICK, v, cfg) >= timeKernel(AUTO_RADIX, v, cfg))
+			break;
+		t.duplicates = profileInput(v.data(), v.data() + v.size()).distinct;
+	}
+
+	return t;
+}
+
+// Prints thresholds t ("never" where calibration found no crossover).
+inline void reportTuning(std::ostream& os, const char* typeName, const AutoSortTuning& t)
+{
+	const std::size_t never = std::numeric_limits<std::size_t>::max();
+	auto size = [&](std::size_t n) { return (n == never) ? std::string("never") : std::to_string(n); };
+	auto fraction = [](double x, bool valid) { return valid ? std::to_string(x) : std::string("never"); };
+
+	os << typeName << " auto sort: insertion n <= " << t.insertionMax
+		<< ", radix n >= " << size(t.radixMin)
+		<< ", parallel n >= " << size(t.parallelMin)
+		<< ", counting span <= " << fraction(t.countingSpan, t.countingSpan >= 0.0)
+		<< ", power sortedness >= " << fraction(t.presorted, t.presorted <= 1.0)
+		<< ", quick distinct <= " << fraction(t.duplicates, t.duplicates > 0.0) << std::endl;
+}
+
+#endif
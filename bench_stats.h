@@ -0,0 +1,212 @@
+/*************************************************************************
+* Title: Benchmark Statistics.
+* File: bench_stats.h
+* Date: 10/16/2026
+*
+* Measurement engine support used by Sort::benchmark:
+*   benchmark settings (BenchConfig)
+*   per-cell summary statistics (BenchStats)
+*   sample reduction (computeStats)
+*   timed trial and adaptive measurement loop (timedRun, measure)
+*
+* Notes:
+*  (1) All times are reported in milliseconds.
+*  (2) Repetition is adaptive: trials continue until the 95% confidence
+*      interval of the mean is within BenchConfig::maxRelCI of the mean,
+*      or until the trial count or time budget is exhausted.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Add first-touch hook for the work array.
+*   10/16/2026: Move measurement loop out of Sort::benchmark for reuse.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _BENCH_STATS_H_
+#define _BENCH_STATS_H_
+
+// Benchmark measurement settings.
+struct BenchConfig
+{
+	int warmups = 1;          // Untimed warm-up runs before measuring.
+	int minTrials = 5;        // Minimum number of timed trials.
+	int maxTrials = 100;      // Maximum number of timed trials.
+	double maxRelCI = 0.02;   // Target 95% CI half-width relative to mean.
+	double maxSeconds = 10.0; // Time budget for all trials of one cell.
+	bool report = true;       // Print a summary line to stdout.
+	bool counters = false;    // Read hardware performance counters.
+	void (*firstTouch)(void*, std::size_t) = nullptr; // Places work array pages (bytes) before trials.
+};
+
+// Summary statistics of one (algorithm, n, order) benchmark cell.
+struct BenchStats
+{
+	std::size_t trials = 0;   // Number of timed trials.
+	double min = 0.0;         // Fastest trial (ms).
+	double median = 0.0;      // Median trial (ms).
+	double p95 = 0.0;         // 95th percentile trial (ms).
+	double mean = 0.0;        // Arithmetic mean (ms).
+	double stddev = 0.0;      // Sample standard deviation (ms).
+	double ci95 = 0.0;        // Half-width of 95% confidence interval of mean (ms).
+	PerfTotals perf;          // Hardware counters, if requested.
+};
+
+// Two-sided 95% Student t critical value for df degrees of freedom.
+inline double tCritical95(std::size_t df)
+{
+	static const double table[] = {
+		12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+		2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+		2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+	};
+
+	if (df == 0)
+		return 0.0;
+
+	return (df <= 30) ? table[df - 1] : 1.960;
+}
+
+// Nearest-rank percentile (p in [0, 1]) of sorted samples.
+inline double percentile(const std::vector<double>& sorted, double p)
+{
+	if (sorted.empty())
+		return 0.0;
+
+	std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+
+	return sorted[(rank ? rank : 1) - 1];
+}
+
+// Reduces timing samples (ms) to summary statistics.
+inline BenchStats computeStats(std::vector<double> samples)
+{
+	BenchStats s;
+
+	s.trials = samples.size();
+	if (samples.empty())
+		return s;
+
+	std::sort(samples.begin(), samples.end());
+
+	s.min = samples.front();
+	s.p95 = percentile(samples, 0.95);
+
+	const std::size_t mid = samples.size()/2;
+	s.median = (samples.size() % 2) ? samples[mid] : (samples[mid - 1] + samples[mid])/2.0;
+
+	s.mean = std::accumulate(samples.begin(), samples.end(), 0.0)/samples.size();
+
+	if (samples.size() > 1)
+	{
+		double sq = 0.0;
+
+		for (double x : samples)
+			sq += (x - s.mean)*(x - s.mean);
+
+		s.stddev = std::sqrt(sq/(samples.size() - 1));
+		s.ci95 = tCritical95(samples.size() - 1)*s.stddev/std::sqrt(double(samples.size()));
+	}
+
+	return s;
+}
+
+// True when the confidence interval is tight enough to stop sampling.
+inline bool converged(const BenchStats& s, const BenchConfig& cfg)
+{
+	return s.mean > 0.0 && (s.ci95/s.mean) <= cfg.maxRelCI;
+}
+
+// Runs prepare(), body() and check() in turn. Only body() is timed and, 
+// when counters are supplied, counted; heap allocations made by body() 
+// are added to perf. Returns the duration in ms.
+template <typename Prepare, typename Body, typename Check>
+double timedRun(Prepare prepare, Body body, Check check, PerfCounters* counters = nullptr, PerfTotals* perf = nullptr)
+{
+	prepare();
+
+	if (counters)
+		counters->start();
+
+	const std::size_t allocations = allocationCount;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	body();
+	std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+
+	if (perf)
+	{
+		perf->allocations += double(allocationCount - allocations);
+		perf->runs++;
+	}
+
+	if (counters)
+	{
+		counters->stop();
+		counters->accumulate(*perf);
+	}
+
+	check();
+
+	return duration.count();
+}
+
+// Adaptive measurement loop. run(counters, perf) performs one trial and
+// returns its time in ms; warm-up runs are made without counters.
+template <typename Run>
+BenchStats measure(Run run, const BenchConfig& cfg)
+{
+	std::vector<double> samples;
+	double budget = 0.0;
+
+	// Optional hardware counters around each timed trial.
+	std::unique_ptr<PerfCounters> counters(cfg.counters ? new PerfCounters : nullptr);
+	PerfTotals perf;
+
+	if (counters && !counters->available())
+		counters.reset();
+
+	// Warm-up runs (untimed) prime caches, page tables and branch predictors.
+	for (int i = 0; i < cfg.warmups && budget < cfg.maxSeconds; i++)
+		budget += run(nullptr, nullptr)/1000.0;
+
+	for (budget = 0.0; samples.size() < std::size_t(cfg.maxTrials); )
+	{
+		double ms = run(counters.get(), &perf);
+
+		samples.push_back(ms);
+		budget += ms/1000.0;
+
+		// Stop on time budget, or once the confidence interval is tight.
+		if (budget >= cfg.maxSeconds)
+			break;
+
+		if (samples.size() >= std::size_t(cfg.minTrials) && converged(computeStats(samples), cfg))
+			break;
+	}
+
+	BenchStats stats = computeStats(samples);
+	stats.perf = perf;
+
+	return stats;
+}
+
+// Prints the summary of one cell of n elements, if reporting is enabled.
+inline void reportStats(const BenchStats& stats, const BenchConfig& cfg, long long n)
+{
+	if (!cfg.report)
+		return;
+
+	std::cout << "median: " << stats.median << "ms, min: " << stats.min << "ms, p95: " 
+		<< stats.p95 << "ms, stddev: " << stats.stddev << "ms (" << stats.trials << " trials, "
+		<< stats.perf.allocationsPerRun() << " allocations/call)" << std::endl;
+
+	if (cfg.counters && !stats.perf.any())
+		std::cout << "  counters unavailable" << std::endl;
+	else if (cfg.counters)
+	{
+		std::cout << "  IPC: " << stats.perf.ipc() << ", per element:";
+		for (int e = 0; e < PERF_EVENTS; e++)
+			if (stats.perf.valid[e])
+				std::cout << ' ' << perfEventName(e) << ' ' << stats.perf.perElement(e, n);
+		std::cout << std::endl;
+	}
+}
+
+#endif
@@ -0,0 +1,471 @@
+/*************************************************************************
+* Title: External Sort.
+* File: external_sort.h
+* Date: 10/16/2026
+*
+* Out-of-core sort of binary files of fixed-width keys:
+*   run generation with an in-memory sort kernel (externalSort)
+*   k-way loser tree merge (LoserTree)
+*   double-buffered asynchronous block I/O (BlockReader, BlockWriter)
+*   streaming test file generation and verification (writeTestFile,
+*   verifySortedFile)
+*
+* Notes:
+*  (1) The memory budget covers every buffer. Run generation sorts chunks
+*      of half the budget, leaving the other half for the kernel's scratch
+*      (radix sort needs n). Merging splits the budget into two blocks per
+*      input run plus two output blocks.
+*  (2) When there are more runs than the budget allows at the minimum
+*      block size, groups of runs are merged into longer runs first, so
+*      a sort may take several merge passes.
+*  (3) While one block is being merged the next is read (or the previous
+*      one written) on another thread with std::async.
+*  (4) Run files are written to the temporary directory and removed when
+*      merged, or when the sort fails.
+*  (5) Files are plain arrays of T in native byte order.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Generate test files with the seeded test data generator.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _EXTERNAL_SORT_H_
+#define _EXTERNAL_SORT_H_
+
+// External sort settings.
+struct ExternalConfig
+{
+	std::size_t memoryBytes = std::size_t(256) << 20; // Budget for all sort and I/O buffers.
+	std::size_t blockBytes = std::size_t(1) << 20;    // Smallest merge I/O block.
+	std::string tempDir = ".";                        // Directory for run files.
+};
+
+// Work done by one external sort.
+struct ExternalStats
+{
+	std::size_t elements = 0;  // Keys sorted.
+	std::size_t bytes = 0;     // Input file size.
+	std::size_t runs = 0;      // Initial sorted runs.
+	int passes = 0;            // Merge passes.
+	double runSeconds = 0.0;   // Run generation time.
+	double mergeSeconds = 0.0; // Merge time.
+
+	double seconds() const { return runSeconds + mergeSeconds; }
+
+	// Input bytes sorted per second, in GB/s (10^9 bytes).
+	double gbPerSec() const { return seconds() > 0.0 ? bytes/seconds()/1.0e9 : 0.0; }
+};
+
+// Closes a stdio file.
+struct FileCloser
+{
+	void operator() (std::FILE* f) const { std::fclose(f); }
+};
+
+typedef std::unique_ptr<std::FILE, FileCloser> FilePtr;
+
+// Opens a file, throwing on failure. Stdio buffering is disabled since
+// all transfers are whole blocks.
+inline FilePtr openFile(const std::string& path, const char* mode)
+{
+	FilePtr f(std::fopen(path.c_str(), mode));
+
+	if (!f)
+		throw std::runtime_error("cannot open " + path);
+
+	std::setvbuf(f.get(), nullptr, _IONBF, 0);
+
+	return f;
+}
+
+// Removes the listed files on destruction.
+struct TempFiles
+{
+	std::vector<std::string> paths;
+
+	TempFiles() = default;
+	TempFiles(const TempFiles&) = delete;
+	TempFiles& operator= (const TempFiles&) = delete;
+
+	~TempFiles()
+	{
+		for (const std::string& p : paths)
+			std::remove(p.c_str());
+	}
+
+	// Returns a new, unique file name in dir.
+	std::string add(const std::string& dir)
+	{
+		static std::atomic<unsigned> counter{ 0 };
+
+		paths.push_back(dir + "/sort_run_" + std::to_string(counter++) + ".tmp");
+
+		return paths.back();
+	}
+};
+
+/*************************************************************************
+ * Sequential reader of a file of T, reading the next block while the
+ * current one is consumed.
+ *************************************************************************/
+template <typename T>
+class BlockReader
+{
+public:
+	BlockReader(const std::string& path, std::size_t block)
+		: file(openFile(path, "rb")), block(block), cur(new T[block]), next(new T[block])
+	{
+		pending = readNext();
+		fill();
+	}
+
+	BlockReader(const BlockReader&) = delete;
+	BlockReader& operator= (const BlockReader&) = delete;
+
+	bool empty() const { return pos == len; }
+	const T& front() const { return cur[pos]; }
+
+	void pop()
+	{
+		if (++pos == len)
+			fill();
+	}
+
+private:
+	std::future<std::size_t> readNext()
+	{
+		return std::async(std::launch::async, [this] {
+			const std::size_t m = std::fread(next.get(), sizeof(T), block, file.get());
+
+			if (m < block && std::ferror(file.get()))
+				throw std::runtime_error("read failed");
+
+			return m;
+		});
+	}
+
+	// Makes the prefetched block current and starts reading the next.
+	void fill()
+	{
+		len = pending.get();
+		pos = 0;
+		std::swap(cur, next);
+
+		if (len)
+			pending = readNext();
+	}
+
+	FilePtr file;
+	std::size_t block;                 // Keys per block.
+	std::unique_ptr<T[]> cur, next;    // Block being consumed, block being read.
+	std::size_t pos = 0, len = 0;      // Position and size of current block.
+	std::future<std::size_t> pending;  // Read in progress (declared last, so waited for first).
+};
+
+/*************************************************************************
+ * Sequential writer of a file of T, writing the previous block while the
+ * next one is filled.
+ *************************************************************************/
+template <typename T>
+class BlockWriter
+{
+public:
+	BlockWriter(const std::string& path, std::size_t block)
+		: file(openFile(path, "wb")), block(block), cur(new T[block]), next(new T[block]) { }
+
+	BlockWriter(const BlockWriter&) = delete;
+	BlockWriter& operator= (const BlockWriter&) = delete;
+
+	void push(const T& v)
+	{
+		cur[pos++] = v;
+
+		if (pos == block)
+			flush();
+	}
+
+	// Writes the remaining keys and reports any write error.
+	void finish()
+	{
+		flush();
+		wait();
+
+		if (std::fflush(file.get()) != 0)
+			throw std::runtime_error("write failed");
+	}
+
+private:
+	void wait()
+	{
+		if (pending.valid())
+			pending.get();
+	}
+
+	// Starts writing the current block once the previous write is done.
+	void flush()
+	{
+		wait();
+		std::swap(cur, next);
+
+		const std::size_t m = pos;
+		pos = 0;
+
+		if (m)
+			pending = std::async(std::launch::async, [this, m] {
+				if (std::fwrite(next.get(), sizeof(T), m, file.get()) != m)
+					throw std::runtime_error("write failed");
+			});
+	}
+
+	FilePtr file;
+	std::size_t block;               // Keys per block.
+	std::unique_ptr<T[]> cur, next;  // Block being filled, block being written.
+	std::size_t pos = 0;             // Keys in current block.
+	std::future<void> pending;       // Write in progress (declared last, so waited for first).
+};
+
+/*************************************************************************
+ * Tree of losers selecting the smallest head key of k sorted inputs in
+ * log2(k) comparisons per key. Ties go to the lower input index, so the
+ * merge is stable with respect to input order.
+ *************************************************************************/
+template <typename T>
+class LoserTree
+{
+public:
+	explicit LoserTree(std::size_t k) : k(k), tree(k), key(k), live(k, false) { }
+
+	// Sets the head key of input i.
+	void set(std::size_t i, const T& v)
+	{
+		key[i] = v;
+		live[i] = true;
+	}
+
+	// Marks input i exhausted.
+	void close(std::size_t i) { live[i] = false; }
+
+	// Plays all matches; call once after the initial set() calls.
+	void build()
+	{
+		std::vector<std::size_t> winners(2*k);
+
+		for (std::size_t i = 0; i < k; i++)
+			winners[k + i] = i;
+
+		for (std::size_t node = k - 1; node > 0; node--)
+		{
+			const std::size_t a = winners[2*node], b = winners[2*node + 1];
+
+			winners[node] = beats(a, b) ? a : b;
+			tree[node] = beats(a, b) ? b : a;
+		}
+
+		tree[0] = (k > 1) ? winners[1] : 0;
+	}
+
+	// Input holding the smallest key.
+	std::size_t winner() const { return tree[0]; }
+
+	// True when every input is exhausted.
+	bool empty() const { return !live[tree[0]]; }
+
+	const T& top() const { return key[tree[0]]; }
+
+	// Replays the matches on the path of input i after its key changed.
+	void replay(std::size_t i)
+	{
+		std::size_t w = i;
+
+		for (std::size_t node = (i + k)/2; node > 0; node /= 2)
+			if (beats(tree[node], w))
+				std::swap(tree[node], w);
+
+		tree[0] = w;
+	}
+
+private:
+	bool beats(std::size_t a, std::size_t b) const
+	{
+		if (!live[a] || !live[b])
+			return live[a];
+
+		return key[a] < key[b] || (!(key[b] < key[a]) && a < b);
+	}
+
+	std::size_t k;                   // Number of inputs.
+	std::vector<std::size_t> tree;   // Loser of each match; tree[0] is the winner.
+	std::vector<T> key;              // Head key of each input.
+	std::vector<unsigned char> live; // Input not exhausted.
+};
+
+// Merges the sorted run files into output within memoryBytes of buffers.
+template <typename T>
+void mergeRuns(const std::vector<std::string>& runs, const std::string& output, std::size_t memoryBytes)
+{
+	const std::size_t k = runs.size();
+	const std::size_t block = std::max<std::size_t>(memoryBytes/(2*(k + 1))/sizeof(T), 1);
+	std::vector<std::unique_ptr<BlockReader<T>>> readers;
+	LoserTree<T> tree(k);
+
+	for (std::size_t i = 0; i < k; i++)
+	{
+		readers.emplace_back(new BlockReader<T>(runs[i], block));
+
+		if (!readers[i]->empty())
+			tree.set(i, readers[i]->front());
+	}
+
+	BlockWriter<T> out(output, block);
+
+	tree.build();
+
+	while (!tree.empty())
+	{
+		const std::size_t i = tree.winner();
+		BlockReader<T>& r = *readers[i];
+
+		out.push(tree.top());
+		r.pop();
+
+		if (r.empty())
+			tree.close(i);
+		else
+			tree.set(i, r.front());
+
+		tree.replay(i);
+	}
+
+	out.finish();
+}
+
+/*************************************************************************
+ * Sorts the keys of file input into file output, using in-memory sort S
+ * for the initial runs and at most cfg.memoryBytes of buffers.
+ *************************************************************************/
+template <typename T, void(*S)(T*, T*) = radixSort<T>>
+ExternalStats externalSort(const std::string& input, const std::string& output, const ExternalConfig& cfg = {})
+{
+	typedef std::chrono::steady_clock clock;
+	ExternalStats stats;
+	TempFiles temp;
+	std::vector<std::string> runs;
+
+	// Run generation: sort chunks of half the budget and spill them.
+	auto start = clock::now();
+	{
+		const std::size_t chunk = std::max<std::size_t>(cfg.memoryBytes/(2*sizeof(T)), 1);
+		std::unique_ptr<T[]> buffer(new T[chunk]);
+		FilePtr in = openFile(input, "rb");
+
+		for (;;)
+		{
+			const std::size_t m = std::fread(buffer.get(), sizeof(T), chunk, in.get());
+
+			if (m < chunk && std::ferror(in.get()))
+				throw std::runtime_error("read failed: " + input);
+
+			if (m == 0)
+				break;
+
+			S(buffer.get(), buffer.get() + m);
+
+			runs.push_back(temp.add(cfg.tempDir));
+			FilePtr run = openFile(runs.back(), "wb");
+
+			if (std::fwrite(buffer.get(), sizeof(T), m, run.get()) != m)
+				throw std::runtime_error("write failed: " + runs.back());
+
+			stats.elements += m;
+		}
+	}
+	stats.runs = runs.size();
+	stats.bytes = stats.elements*sizeof(T);
+	stats.runSeconds = std::chrono::duration<double>(clock::now() - start).count();
+
+	// Merge passes, as many runs at a time as the budget allows.
+	start = clock::now();
+
+	const std::size_t fanIn = std::max<std::size_t>(cfg.memoryBytes/(2*cfg.blockBytes), 3) - 1;
+
+	if (runs.size() == 1 && std::rename(runs[0].c_str(), output.c_str()) == 0)
+		runs.clear();
+	else if (runs.empty())
+		openFile(output, "wb");
+
+	while (!runs.empty())
+	{
+		stats.passes++;
+
+		if (runs.size() <= fanIn)
+		{
+			mergeRuns<T>(runs, output, cfg.memoryBytes);
+			break;
+		}
+
+		std::vector<std::string> merged;
+
+		for (std::size_t i = 0; i < runs.size(); i += fanIn)
+		{
+			const std::vector<std::string> group(runs.begin() + i, runs.begin() + std::min(i + fanIn, runs.size()));
+
+			merged.push_back(temp.add(cfg.tempDir));
+			mergeRuns<T>(group, merged.back(), cfg.memoryBytes);
+
+			for (const std::string& r : group)
+				std::remove(r.c_str());
+		}
+
+		runs.swap(merged);
+	}
+
+	stats.mergeSeconds = std::chrono::duration<double>(clock::now() - start).count();
+
+	return stats;
+}
+
+/*************************************************************************
+ * Streams n keys of the given order to a file, in chunks of at most
+ * chunk keys, generated as constructTestArray does (swaps within each 
+ * chunk).
+ *************************************************************************/
+template <typename T>
+void writeTestFile(const std::string& path, std::size_t n, order type, std::size_t chunk = std::size_t(1) << 20)
+{
+	const uint64_t seed = testDataConfig().seed;
+	std::unique_ptr<T[]> buffer(new T[chunk]);
+	FilePtr f = openFile(path, "wb");
+
+	for (std::size_t base = 0; base < n; base += chunk)
+	{
+		const std::size_t m = std::min(chunk, n - base);
+
+		fillTestKeys(buffer.get(), base, m, n, type, seed);
+		applyTestSwaps(buffer.get(), m, type, seed + base);
+
+		if (std::fwrite(buffer.get(), sizeof(T), m, f.get()) != m)
+			throw std::runtime_error("write failed: " + path);
+	}
+}
+
+/*************************************************************************
+ * Throws unless the file holds n keys in non-decreasing order.
+ *************************************************************************/
+template <typename T>
+void verifySortedFile(const std::string& path, std::size_t n, std::size_t block = std::size_t(1) << 20)
+{
+	BlockReader<T> r(path, block);
+	std::size_t count = 0;
+
+	for (T prev = T(); !r.empty(); r.pop(), count++)
+	{
+		if (count && r.front() < prev)
+			throw std::runtime_error("external sort failed");
+
+		prev = r.front();
+	}
+
+	if (count != n)
+		throw std::runtime_error("external sort failed");
+}
+
+#endif
@@ -0,0 +1,267 @@
+/*************************************************************************
+* Title: Incremental Log-Structured Sorted Array.
+* File: lsm_sort.h
+* Date: 10/16/2026
+*
+* Sorted container that absorbs appended keys without re-sorting the
+* whole array (LsmArray), and its merge counters (LsmStats):
+*   appends go to an unsorted buffer of batch keys
+*   a full buffer is sorted (insertionSort or radixSort) into a run
+*   runs are merged into sorted levels of growing capacity
+*   range queries search every level and scan the buffer
+*
+* Notes:
+*  (1) Level i holds at most batch * growth^(i + 1) keys.  A new run
+*      cascades down to the first level that can hold it together with
+*      every level above, and one multiwayMerge writes them all there,
+*      so each key is rewritten about growth/2 times per level over its
+*      lifetime, O(growth log(n/batch)/log(growth)) amortized moves.
+*  (2) Batches of at most the auto sort insertion limit use insertionSort,
+*      larger ones radixSort with a reused buffer (std::sort for keys
+*      without a radix key).
+*  (3) Queries are valid at any time: each level is sorted and searched
+*      with binary search, and the small unsorted buffer is scanned.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _LSM_SORT_H_
+#define _LSM_SORT_H_
+
+constexpr std::size_t LSM_BATCH{ 4096 }; // Default keys buffered per run.
+constexpr std::size_t LSM_GROWTH{ 4 };   // Default capacity ratio of adjacent levels.
+
+// Merge work of an LsmArray.
+struct LsmStats
+{
+	std::size_t inserted = 0;   // Keys appended.
+	std::size_t runs = 0;       // Buffers sorted into runs.
+	std::size_t merges = 0;     // Level merges.
+	std::size_t keysMoved = 0;  // Keys written by level merges.
+};
+
+template <typename T>
+class LsmArray
+{
+public:
+	explicit LsmArray(std::size_t batch = LSM_BATCH, std::size_t growth = LSM_GROWTH)
+		: batch(std::max<std::size_t>(batch, 1)), growth(std::max<std::size_t>(growth, 2))
+	{
+		buffer.reserve(this->batch);
+	}
+
+	// Appends key, sorting and merging the buffer when it fills.
+	void insert(const T& key)
+	{
+		buffer.push_back(key);
+		counters.inserted++;
+
+		if (buffer.size() == batch)
+			flush();
+	}
+
+	// Appends the keys [begin, end).
+	void insert(const T* begin, const T* end)
+	{
+		while (begin != end)
+		{
+			const std::size_t take = std::min<std::size_t>(batch - buffer.size(), end - begin);
+
+			buffer.insert(buffer.end(), begin, begin + take);
+			counters.inserted += take;
+			begin += take;
+
+			if (buffer.size() == batch)
+				flush();
+		}
+	}
+
+	// Sorts the buffered keys into a run and merges it into the levels.
+	void flush()
+	{
+		if (buffer.empty())
+			return;
+
+		sortBatch();
+		counters.runs++;
+
+		// Deepest level the run cascades to.
+		std::size_t total = buffer.size(), last = 0;
+
+		for (; ; last++)
+		{
+			if (last == levels.size())
+				levels.emplace_back();
+
+			total += levels[last].size();
+
+			if (total <= capacity(last))
+				break;
+		}
+
+		SortedRuns<T> runs{ { buffer.data(), buffer.data() + buffer.size() } };
+
+		for (std::size_t i = 0; i <= last; i++)
+			if (!levels[i].empty())
+				runs.emplace_back(levels[i].data(), levels[i].data() + levels[i].size());
+
+		if (runs.size() > 1)
+		{
+			counters.merges++;
+			counters.keysMoved += total;
+		}
+
+		std::vector<T> merged(total);
+		multiwayMerge(runs, merged.data());
+
+		for (std::size_t i = 0; i < last; i++)
+			std::vector<T>().swap(levels[i]);
+
+		levels[last].swap(merged);
+		buffer.clear();
+	}
+
+	// Merges everything into a single sorted level.
+	void compact()
+	{
+		flush();
+
+		if (levels.size() < 2)
+			return;
+
+		SortedRuns<T> runs;
+		std::size_t total = 0;
+
+		for (const std::vector<T>& l : levels)
+		{
+			runs.emplace_back(l.data(), l.data() + l.size());
+			total += l.size();
+		}
+
+		std::vector<T> merged(total);
+		multiwayMerge(runs, merged.data());
+		counters.merges++;
+		counters.keysMoved += total;
+
+		levels.clear();
+		levels.push_back(std::move(merged));
+	}
+
+	std::size_t size() const
+	{
+		std::size_t n = buffer.size();
+
+		for (const std::vector<T>& l : levels)
+			n += l.size();
+
+		return n;
+	}
+
+	// Number of keys in [lo, hi).
+	std::size_t count(const T& lo, const T& hi) const
+	{
+		std::size_t n = std::count_if(buffer.begin(), buffer.end(), [&](const T& x) { return !(x < lo) && x < hi; });
+
+		for (const std::vector<T>& l : levels)
+			n += std::lower_bound(l.begin(), l.end(), hi) - std::lower_bound(l.begin(), l.end(), lo);
+
+		return n;
+	}
+
+	bool contains(const T& key) const
+	{
+		for (const std::vector<T>& l : levels)
+			if (std::binary_search(l.begin(), l.end(), key))
+				return true;
+
+		return std::find(buffer.begin(), buffer.end(), key) != buffer.end();
+	}
+
+	// Replaces out with the keys in [lo, hi) in sorted order.
+	void range(const T& lo, const T& hi, std::vector<T>& out) const
+	{
+		std::vector<T> pending;
+		SortedRuns<T> runs;
+		std::size_t total = 0;
+
+		for (const T& x : buffer)
+			if (!(x < lo) && x < hi)
+				pending.push_back(x);
+
+		std::sort(pending.begin(), pending.end());
+		runs.emplace_back(pending.data(), pending.data() + pending.size());
+		total += pending.size();
+
+		for (const std::vector<T>& l : levels)
+		{
+			const T* first = l.data() + (std::lower_bound(l.begin(), l.end(), lo) - l.begin());
+			const T* last = l.data() + (std::lower_bound(l.begin(), l.end(), hi) - l.begin());
+
+			runs.emplace_back(first, last);
+			total += last - first;
+		}
+
+		out.resize(total);
+		multiwayMerge(runs, out.data());
+	}
+
+	// Replaces out with every key in sorted order.
+	void sorted(std::vector<T>& out) const
+	{
+		std::vector<T> pending(buffer);
+		SortedRuns<T> runs;
+
+		std::sort(pending.begin(), pending.end());
+		runs.emplace_back(pending.data(), pending.data() + pending.size());
+
+		for (const std::vector<T>& l : levels)
+			runs.emplace_back(l.data(), l.data() + l.size());
+
+		out.resize(size());
+		multiwayMerge(runs, out.data());
+	}
+
+	std::size_t levelCount() const { return levels.size(); }
+	const LsmStats& stats() const { return counters; }
+
+private:
+	std::size_t capacity(std::size_t level) const
+	{
+		std::size_t c = batch*growth;
+
+		while (level--)
+			c *= growth;
+
+		return c;
+	}
+
+	void sortBatch()
+	{
+		T* begin = buffer.data(), * end = begin + buffer.size();
+
+		if (buffer.size() <= autoSortTuning<T>().insertionMax)
+			insertionSort(begin, end);
+		else if constexpr (std::is_arithmetic<T>::value)
+		{
+			scratch.resize(buffer.size());
+			radixSort(begin, end, scratch.data());
+		}
+		else
+			std::sort(begin, end);
+	}
+
+	std::size_t batch, growth;
+	std::vector<T> buffer;              // Unsorted appends.
+	std::vector<T> scratch;             // Radix sort buffer.
+	std::vector<std::vector<T>> levels; // Sorted, level i at most capacity(i) keys.
+	LsmStats counters;
+};
+
+// Prints the merge work per inserted key.
+inline void reportLsmStats(std::ostream& os, const LsmStats& s, std::size_t levels)
+{
+	os << "  " << s.inserted << " keys, " << s.runs << " runs, " << s.merges << " merges, " << levels << " levels, "
+		<< (s.inserted ? double(s.keysMoved)/s.inserted : 0.0) << " merge writes per key" << std::endl;
+}
+
+#endif
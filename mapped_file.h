@@ -0,0 +1,263 @@
+/*************************************************************************
+* Title: Memory-Mapped Files.
+* File: mapped_file.h
+* Date: 10/16/2026
+*
+* Binary key files mapped into memory (MappedFile), and a benchmark of
+* the whole map, copy, sort and write-back path over such a file
+* (benchFile).
+*
+* Notes:
+*  (1) A file is sorted one of three ways:
+*        private (default): copy-on-write mapping, file left unchanged
+*        in place: shared mapping, sorted keys written back to the file
+*        output: keys copied from a read-only mapping into a new mapped
+*                output file, which is sorted and written back
+*  (2) Each trial maps the file again, so the timing includes page
+*      faults, page cache reads and (shared mappings) msync. Warm-up
+*      runs leave the file in the page cache; evict it beforehand to
+*      measure cold reads.
+*  (3) Advice: WILLNEED and SEQUENTIAL on read paths; optionally
+*      HUGEPAGE on sorted mappings (effective where the kernel supports
+*      huge pages for the file system).
+*  (4) On platforms without mmap the file is read into and written back
+*      from heap memory.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _MAPPED_FILE_H_
+#define _MAPPED_FILE_H_
+
+// Memory-mapped file benchmark settings.
+struct FileConfig
+{
+	std::string input;       // Binary file of keys.
+	std::string output;      // Mapped output file; empty sorts the input mapping.
+	bool inPlace = false;    // Write the sorted keys back to the input file.
+	bool hugePages = false;  // Advise huge pages for the sorted mapping.
+};
+
+/*************************************************************************
+ * File mapped into memory for the lifetime of the object.
+ *************************************************************************/
+class MappedFile
+{
+public:
+	enum mode
+	{
+		READ_ONLY,  // Read-only view.
+		PRIVATE,    // Writable, changes are not written to the file.
+		SHARED,     // Writable, changes are written to the file.
+		CREATE      // New file of the given size, as SHARED.
+	};
+
+	enum advice { SEQUENTIAL, RANDOM, WILLNEED, HUGEPAGE };
+
+	MappedFile(const std::string& path, mode m, std::size_t bytes = 0) : path(path), fileMode(m)
+	{
+#if defined(__linux__)
+		const int flags = (m == READ_ONLY || m == PRIVATE) ? O_RDONLY : (m == SHARED) ? O_RDWR : (O_RDWR | O_CREAT | O_TRUNC);
+		fd = ::open(path.c_str(), flags, 0644);
+
+		if (fd < 0)
+			throw std::runtime_error("cannot open " + path);
+
+		if (m == CREATE)
+		{
+			if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+			{
+				::close(fd);
+				throw std::runtime_error("cannot resize " + path);
+			}
+		}
+		else
+		{
+			struct stat st;
+
+			if (fstat(fd, &st) != 0)
+			{
+				::close(fd);
+				throw std::runtime_error("cannot stat " + path);
+			}
+
+			bytes = static_cast<std::size_t>(st.st_size);
+		}
+
+		size = bytes;
+
+		if (size)
+		{
+			const int prot = (m == READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+			const int share = (m == PRIVATE) ? MAP_PRIVATE : MAP_SHARED;
+
+			base = mmap(nullptr, size, prot, share, fd, 0);
+
+			if (base == MAP_FAILED)
+			{
+				base = nullptr;
+				::close(fd);
+				throw std::runtime_error("cannot map " + path);
+			}
+		}
+#else
+		FilePtr f;
+
+		if (m == CREATE)
+			f = openFile(path, "wb");
+		else
+		{
+			f = openFile(path, "rb");
+			std::fseek(f.get(), 0, SEEK_END);
+			bytes = static_cast<std::size_t>(std::ftell(f.get()));
+			std::fseek(f.get(), 0, SEEK_SET);
+		}
+
+		size = bytes;
+		base = std::malloc(size ? size : 1);
+
+		if (!base)
+			throw std::bad_alloc();
+
+		if (m != CREATE && std::fread(base, 1, size, f.get()) != size)
+		{
+			std::free(base);
+			throw std::runtime_error("read failed: " + path);
+		}
+#endif
+	}
+
+	~MappedFile()
+	{
+#if defined(__linux__)
+		if (base)
+			munmap(base, size);
+
+		::close(fd);
+#else
+		std::free(base);
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator= (const MappedFile&) = delete;
+
+	void* data() const { return base; }
+	std::size_t bytes() const { return size; }
+
+	// Access pattern hint for the whole mapping.
+	void advise(advice a)
+	{
+#if defined(__linux__)
+		static const int hints[] = {
+			MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED,
+#if defined(MADV_HUGEPAGE)
+			MADV_HUGEPAGE
+#else
+			MADV_NORMAL
+#endif
+		};
+
+		if (base)
+			madvise(base, size, hints[a]);
+#else
+		(void)a;
+#endif
+	}
+
+	// Writes changes of a shared mapping back to the file.
+	void sync()
+	{
+		if (fileMode != SHARED && fileMode != CREATE)
+			return;
+
+#if defined(__linux__)
+		if (base && msync(base, size, MS_SYNC) != 0)
+			throw std::runtime_error("sync failed: " + path);
+#else
+		FilePtr f = openFile(path, "wb");
+
+		if (std::fwrite(base, 1, size, f.get()) != size)
+			throw std::runtime_error("write failed: " + path);
+#endif
+	}
+
+private:
+	std::string path;
+	mode fileMode;
+	void* base = nullptr;    // Start of mapping.
+	std::size_t size = 0;    // Mapping size in bytes.
+#if defined(__linux__)
+	int fd = -1;
+#endif
+};
+
+/*************************************************************************
+ * Benchmarks the full path of sorting the keys of a binary file with
+ * sort S: map, optional copy to the output mapping, sort and write-back.
+ * Sorting in place is a single trial, since it changes its own input.
+ *************************************************************************/
+template <typename T, void(*S)(T*, T*)>
+BenchStats benchFile(const FileConfig& file, const BenchConfig& config)
+{
+	BenchConfig cfg = config;
+	std::unique_ptr<MappedFile> in, out;
+	T* keys = nullptr;
+	std::size_t n = 0;
+
+	if (file.inPlace)
+	{
+		cfg.warmups = 0;
+		cfg.minTrials = cfg.maxTrials = 1;
+	}
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { },
+			[&] {
+				if (!file.output.empty())
+				{
+					in.reset(new MappedFile(file.input, MappedFile::READ_ONLY));
+					in->advise(MappedFile::SEQUENTIAL);
+					in->advise(MappedFile::WILLNEED);
+					out.reset(new MappedFile(file.output, MappedFile::CREATE, in->bytes()));
+
+					if (file.hugePages)
+						out->advise(MappedFile::HUGEPAGE);
+
+					if (in->bytes())
+						std::memcpy(out->data(), in->data(), in->bytes());
+				}
+				else
+				{
+					out.reset(new MappedFile(file.input, file.inPlace ? MappedFile::SHARED : MappedFile::PRIVATE));
+					out->advise(MappedFile::WILLNEED);
+
+					if (file.hugePages)
+						out->advise(MappedFile::HUGEPAGE);
+				}
+
+				if (out->bytes() % sizeof(T))
+					throw std::runtime_error(file.input + " is not a whole number of keys");
+
+				keys = static_cast<T*>(out->data());
+				n = out->bytes()/sizeof(T);
+				S(keys, keys + n);
+				out->sync();
+			},
+			[&] {
+				if (!std::is_sorted(keys, keys + n))
+					throw std::runtime_error("sort failed");
+
+				out.reset();
+				in.reset();
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, static_cast<long long>(n));
+
+	return stats;
+}
+
+#endif
@@ -0,0 +1,438 @@
+/*************************************************************************
+* Title: NUMA-Aware Sort.
+* File: numa_sort.h
+* Date: 10/16/2026
+*
+* Parallel sort for multi-socket hosts that keeps most memory traffic on
+* the local NUMA node:
+*   node and CPU discovery (NumaTopology, detectNumaTopology)
+*   one pinned thread pool per node (NumaContext, numaContext)
+*   first touch of buffers by their owning node (numaFirstTouch)
+*   node-local sort and cross-node merge (numaSort)
+*   local and remote bandwidth (measureNumaBandwidth, NumaStats)
+*
+* Notes:
+*  (1) The n keys are split into one contiguous slice per node.  Pages of
+*      slice j are first touched by node j's threads (numaFirstTouch on the
+*      input, and always for the merge buffer), so Linux places them on
+*      node j.  Each node then sorts its own slice with sampleSort on its
+*      own pool, touching local memory only.
+*  (2) The sorted slices are merged pairwise in log2(nodes) rounds.  Every
+*      node writes only its own slice of the output, locating its share
+*      of each merge by merge path (co-rank) binary search; only the
+*      reads of other nodes' runs cross the interconnect.
+*  (3) With a single node (or off Linux) numaSort is sampleSort on the
+*      shared sort pool and numaFirstTouch does nothing.
+*  (4) Topology comes from /sys/devices/system/node, restricted to the
+*      CPUs in the process affinity mask; no NUMA library is needed.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Comparator overload of mergeCoRank.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _NUMA_SORT_H_
+#define _NUMA_SORT_H_
+
+// NUMA nodes, each with the CPUs of it this process may run on.
+struct NumaTopology
+{
+	std::vector<std::vector<int>> nodes;
+
+	std::size_t size() const { return nodes.size(); }
+};
+
+// Parses a Linux CPU or node list such as "0-3,8,10-11".
+inline std::vector<int> parseCpuList(const std::string& s)
+{
+	std::vector<int> v;
+	std::stringstream ss(s);
+
+	for (std::string item; std::getline(ss, item, ',');)
+	{
+		if (item.empty() || item == "\n")
+			continue;
+
+		const std::size_t dash = item.find('-');
+		const int lo = std::stoi(item.substr(0, dash));
+		const int hi = (dash == std::string::npos) ? lo : std::stoi(item.substr(dash + 1));
+
+		for (int c = lo; c <= hi; c++)
+			v.push_back(c);
+	}
+
+	return v;
+}
+
+// Nodes with CPUs available to this process; one node when unknown.
+inline NumaTopology detectNumaTopology()
+{
+	NumaTopology t;
+	const std::vector<int> cpus = availableCpus();
+
+#if defined(__linux__)
+	std::ifstream online("/sys/devices/system/node/online");
+	std::string line;
+
+	if (online && std::getline(online, line))
+		for (int node : parseCpuList(line))
+		{
+			std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+			std::vector<int> mine;
+
+			if (f && std::getline(f, line))
+				for (int c : parseCpuList(line))
+					if (std::find(cpus.begin(), cpus.end(), c) != cpus.end())
+						mine.push_back(c);
+
+			if (!mine.empty())
+				t.nodes.push_back(mine);
+		}
+#endif
+	if (t.nodes.empty())
+		t.nodes.push_back(cpus);
+
+	return t;
+}
+
+/*************************************************************************
+ * One thread pool per node, pinned to that node's CPUs.  A single node
+ * uses the shared sort pool instead.
+ *************************************************************************/
+class NumaContext
+{
+public:
+	explicit NumaContext(const NumaTopology& topology) : topo(topology)
+	{
+		if (topo.size() > 1)
+			for (const std::vector<int>& cpus : topo.nodes)
+				pools.emplace_back(new ThreadPool(cpus));
+	}
+
+	std::size_t nodes() const { return topo.size(); }
+	const NumaTopology& topology() const { return topo; }
+	ThreadPool& pool(std::size_t node) { return pools.empty() ? sortPool() : *pools[node]; }
+
+	// Runs f(node, part, parts) for every part of every node, each node's
+	// parts on that node's pool, all nodes at once.
+	template <typename F>
+	void parallelNodes(F f)
+	{
+		forEachThread(nodes(), [&](std::size_t node) {
+			ThreadPool& p = pool(node);
+
+			p.parallelFor(p.size(), [&](std::size_t part, unsigned) { f(node, part, std::size_t(p.size())); });
+		});
+	}
+
+private:
+	NumaTopology topo;
+	std::vector<std::unique_ptr<ThreadPool>> pools;
+};
+
+// Shared NUMA context.
+inline std::unique_ptr<NumaContext>& numaContextInstance()
+{
+	static std::unique_ptr<NumaContext> context;
+
+	return context;
+}
+
+// Shared NUMA context, built from the detected topology on first use.
+inline NumaContext& numaContext()
+{
+	std::unique_ptr<NumaContext>& context = numaContextInstance();
+
+	if (!context)
+		context.reset(new NumaContext(detectNumaTopology()));
+
+	return *context;
+}
+
+// Replaces the NUMA context (e.g. to split one node into several).
+inline void configureNuma(const NumaTopology& topology)
+{
+	numaContextInstance().reset(new NumaContext(topology));
+}
+
+// Start of slice j of n items split over k nodes.
+inline std::size_t numaSlice(std::size_t n, std::size_t j, std::size_t k) { return n*j/k; }
+
+// Part [lo, hi) of node slice [first, last) handled by part of parts.
+inline void numaPart(std::size_t first, std::size_t last, std::size_t part, std::size_t parts, std::size_t& lo, std::size_t& hi)
+{
+	lo = first + (last - first)*part/parts;
+	hi = first + (last - first)*(part + 1)/parts;
+}
+
+/*************************************************************************
+ * Benchmark first-touch hook: zeroes slice j of the bytes at p from node
+ * j, which places those pages on node j.
+ *************************************************************************/
+inline void numaFirstTouch(void* p, std::size_t bytes)
+{
+	NumaContext& ctx = numaContext();
+	const std::size_t k = ctx.nodes();
+
+	if (k < 2)
+		return;
+
+	ctx.parallelNodes([&](std::size_t node, std::size_t part, std::size_t parts) {
+		std::size_t lo, hi;
+
+		numaPart(numaSlice(bytes, node, k), numaSlice(bytes, node + 1, k), part, parts, lo, hi);
+		std::memset(static_cast<char*>(p) + lo, 0, hi - lo);
+	});
+}
+
+// Traffic of numaSort calls since the last reset.
+struct NumaStats
+{
+	std::size_t runs = 0;        // numaSort calls on more than one node.
+	double sortMs = 0.0;         // Node-local sort phase.
+	double mergeMs = 0.0;        // Cross-node merge phase.
+	double sortBytes = 0.0;      // Nominal local sort traffic (2 * n * sizeof(T)).
+	double localBytes = 0.0;     // Merge reads from the reading node.
+	double remoteBytes = 0.0;    // Merge reads from other nodes.
+
+	double sortGBs() const { return sortMs > 0.0 ? sortBytes/sortMs/1.0e6 : 0.0; }
+	double localGBs() const { return mergeMs > 0.0 ? localBytes/mergeMs/1.0e6 : 0.0; }
+	double remoteGBs() const { return mergeMs > 0.0 ? remoteBytes/mergeMs/1.0e6 : 0.0; }
+};
+
+inline NumaStats& numaStats()
+{
+	static NumaStats stats;
+
+	return stats;
+}
+
+// Prints the bandwidth numaSort achieved, if it ran on several nodes.
+inline void reportNumaStats(std::ostream& os, const NumaStats& s)
+{
+	if (!s.runs)
+		return;
+
+	const double total = s.localBytes + s.remoteBytes;
+
+	os << "  NUMA: local sort " << s.sortGBs() << " GB/s; merge reads local " << s.localGBs()
+		<< " GB/s, remote " << s.remoteGBs() << " GB/s (" << (total > 0.0 ? 100.0*s.remoteBytes/total : 0.0)
+		<< "% remote)" << std::endl;
+}
+
+/*************************************************************************
+ * Number of keys taken from A among the first i keys of the stable merge
+ * of sorted A (m keys) and B (l keys); ties are taken from A first.
+ *************************************************************************/
+template <typename T, typename Compare>
+std::size_t mergeCoRank(std::size_t i, const T* A, std::size_t m, const T* B, std::size_t l, Compare comp)
+{
+	std::size_t lo = (i > l) ? i - l : 0, hi = std::min(i, m);
+
+	while (lo < hi)
+	{
+		const std::size_t a = lo + (hi - lo)/2;
+
+		// A[a] precedes B[i - a - 1]: more than a keys come from A.
+		if (!comp(B[i - a - 1], A[a]))
+			lo = a + 1;
+		else
+			hi = a;
+	}
+
+	return lo;
+}
+
+template <typename T>
+std::size_t mergeCoRank(std::size_t i, const T* A, std::size_t m, const T* B, std::size_t l) { return mergeCoRank(i, A, m, B, l, std::less<T>()); }
+
+/*************************************************************************
+ * NUMA-aware parallel sort: node-local sorts of one slice per node, then
+ * pairwise merge rounds in which every node writes its own slice.
+ *************************************************************************/
+template <typename T>
+void numaSort(T* begin, T* end)
+{
+	const std::size_t n = std::distance(begin, end);
+	NumaContext& ctx = numaContext();
+	const std::size_t k = ctx.nodes();
+
+	if (k < 2 || n < k*SAMPLE_BASE)
+	{
+		sampleSort(begin, end);
+		return;
+	}
+
+	auto first = [&](std::size_t j) { return numaSlice(n, j, k); };
+	std::unique_ptr<T[]> buffer(new T[n]);
+	std::atomic<std::size_t> localKeys{ 0 }, remoteKeys{ 0 };
+
+	// Place the merge buffer like the input.
+	ctx.parallelNodes([&](std::size_t node, std::size_t part, std::size_t parts) {
+		std::size_t lo, hi;
+
+		numaPart(first(node), first(node + 1), part, parts, lo, hi);
+		std::fill(buffer.get() + lo, buffer.get() + hi, T());
+	});
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	forEachThread(k, [&](std::size_t node) { sampleSort(begin + first(node), begin + first(node + 1), ctx.pool(node)); });
+
+	const std::chrono::steady_clock::time_point sorted = std::chrono::steady_clock::now();
+	T* src = begin, *dst = buffer.get();
+
+	// Round w merges runs of w slices pairwise into runs of 2w slices.
+	for (std::size_t w = 1; w < k; w *= 2)
+	{
+		ctx.parallelNodes([&](std::size_t node, std::size_t part, std::size_t parts) {
+			std::size_t lo, hi;
+
+			numaPart(first(node), first(node + 1), part, parts, lo, hi);
+
+			for (std::size_t p = 0; p < k; p += 2*w)
+			{
+				const std::size_t aLo = first(p), bLo = first(std::min(p + w, k)), bHi = first(std::min(p + 2*w, k));
+				const std::size_t x = std::max(lo, aLo), y = std::min(hi, bHi);
+
+				if (x >= y)
+					continue;
+
+				// This part's share of the merged run [aLo, bHi).
+				const T* A = src + aLo, *B = src + bLo;
+				const std::size_t m = bLo - aLo, l = bHi - bLo;
+				const std::size_t a0 = mergeCoRank(x - aLo, A, m, B, l), a1 = mergeCoRank(y - aLo, A, m, B, l);
+				const std::size_t b0 = x - aLo - a0, b1 = y - aLo - a1;
+
+				std::merge(A + a0, A + a1, B + b0, B + b1, dst + x);
+
+				// Reads inside this node's slice are local.
+				auto local = [&](std::size_t from, std::size_t to) {
+					const std::size_t s = std::max(from, first(node)), e = std::min(to, first(node + 1));
+					return (s < e) ? e - s : 0;
+				};
+				const std::size_t near = local(aLo + a0, aLo + a1) + local(bLo + b0, bLo + b1);
+
+				localKeys += near;
+				remoteKeys += (y - x) - near;
+			}
+		});
+
+		std::swap(src, dst);
+	}
+
+	if (src != begin)
+		ctx.parallelNodes([&](std::size_t node, std::size_t part, std::size_t parts) {
+			std::size_t lo, hi;
+
+			numaPart(first(node), first(node + 1), part, parts, lo, hi);
+			std::copy(src + lo, src + hi, begin + lo);
+		});
+
+	const std::chrono::duration<double, std::milli> sortMs = sorted - start;
+	const std::chrono::duration<double, std::milli> mergeMs = std::chrono::steady_clock::now() - sorted;
+	NumaStats& stats = numaStats();
+
+	stats.runs++;
+	stats.sortMs += sortMs.count();
+	stats.mergeMs += mergeMs.count();
+	stats.sortBytes += 2.0*n*sizeof(T);
+	stats.localBytes += double(localKeys)*sizeof(T);
+	stats.remoteBytes += double(remoteKeys)*sizeof(T);
+}
+
+// Read bandwidth (GB/s) of each node's threads (row) from memory placed
+// on each node (column).
+struct NumaBandwidth
+{
+	std::vector<std::vector<double>> gbs;
+
+	// Mean of the diagonal (local) or off-diagonal (remote) entries; 0 if none.
+	double mean(bool remote) const
+	{
+		double sum = 0.0;
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < gbs.size(); i++)
+			for (std::size_t j = 0; j < gbs.size(); j++)
+				if ((i != j) == remote)
+				{
+					sum += gbs[i][j];
+					count++;
+				}
+
+		return count ? sum/count : 0.0;
+	}
+};
+
+/*************************************************************************
+ * Measures the read bandwidth between every pair of nodes: bytes of
+ * memory are first touched by one node, then read by all threads of
+ * each node in turn (best of a few passes).
+ *************************************************************************/
+inline NumaBandwidth measureNumaBandwidth(std::size_t bytes = std::size_t(64) << 20)
+{
+	NumaContext& ctx = numaContext();
+	const std::size_t k = ctx.nodes(), words = bytes/sizeof(uint64_t);
+	NumaBandwidth bw;
+
+	bw.gbs.assign(k, std::vector<double>(k, 0.0));
+
+	for (std::size_t mem = 0; mem < k; mem++)
+	{
+		std::unique_ptr<uint64_t[]> buf(new uint64_t[words]);
+		ThreadPool& owner = ctx.pool(mem);
+
+		owner.parallelFor(owner.size(), [&](std::size_t part, unsigned) {
+			std::size_t lo, hi;
+
+			numaPart(0, words, part, owner.size(), lo, hi);
+			std::fill(buf.get() + lo, buf.get() + hi, uint64_t(part));
+		});
+
+		for (std::size_t cpu = 0; cpu < k; cpu++)
+		{
+			ThreadPool& reader = ctx.pool(cpu);
+			std::atomic<uint64_t> sink{ 0 };
+
+			for (int pass = 0; pass < 3; pass++)
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+				reader.parallelFor(reader.size(), [&](std::size_t part, unsigned) {
+					std::size_t lo, hi;
+
+					numaPart(0, words, part, reader.size(), lo, hi);
+					sink += std::accumulate(buf.get() + lo, buf.get() + hi, uint64_t(0));
+				});
+
+				const std::chrono::duration<double> s = std::chrono::steady_clock::now() - start;
+				bw.gbs[cpu][mem] = std::max(bw.gbs[cpu][mem], words*sizeof(uint64_t)/s.count()/1.0e9);
+			}
+		}
+	}
+
+	return bw;
+}
+
+// Prints the topology and a bandwidth matrix.
+inline void reportNumaBandwidth(std::ostream& os, const NumaTopology& topo, const NumaBandwidth& bw)
+{
+	os << "NUMA nodes: " << topo.size() << std::endl;
+
+	for (std::size_t i = 0; i < bw.gbs.size(); i++)
+	{
+		os << "  node " << i << " (" << topo.nodes[i].size() << " cpus) reading node 0.." << bw.gbs.size() - 1 << " GB/s:";
+		for (double g : bw.gbs[i])
+			os << ' ' << g;
+		os << std::endl;
+	}
+
+	os << "  local " << bw.mean(false) << " GB/s";
+	if (bw.gbs.size() > 1)
+		os << ", remote " << bw.mean(true) << " GB/s";
+	else
+		os << " (single node: numa sort runs the plain parallel sample sort)";
+	os << std::endl;
+}
+
+#endif
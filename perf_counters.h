@@ -0,0 +1,162 @@
+/*************************************************************************
+* Title: Hardware Performance Counters.
+* File: perf_counters.h
+* Date: 10/16/2026
+*
+* Optional Linux perf_event instrumentation of the timed region:
+*   cycles, instructions, L1D read misses, last level cache misses,
+*   branch misses and data TLB read misses.
+* Heap allocation count of the timed region (allocationCount).
+*
+* Notes:
+*  (1) Each event is opened separately so an event the PMU (or the
+*      kernel's perf_event_paranoid setting) refuses does not disable
+*      the others. Counts are scaled for multiplexing.
+*  (2) On other platforms, or when no event can be opened, available()
+*      is false and the benchmark reports wall-clock time only.
+*  (3) allocationCount is incremented by the replacement operator new in
+*      sortTimer.cpp and by scratch arena growth; it is always counted.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Add heap allocation count.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _PERF_COUNTERS_H_
+#define _PERF_COUNTERS_H_
+
+// Heap allocations made by the process.
+inline std::atomic<std::size_t> allocationCount{ 0 };
+
+// Counted hardware events.
+enum perfEvent { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES, PERF_EVENTS };
+
+// Printable name of a counted event.
+inline const char* perfEventName(int e)
+{
+	static const char* names[PERF_EVENTS] = {
+		"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+	};
+
+	return names[e];
+}
+
+// Counter totals accumulated over the timed runs of one benchmark cell.
+struct PerfTotals
+{
+	bool valid[PERF_EVENTS] = {};     // Event could be counted.
+	double count[PERF_EVENTS] = {};   // Total over all runs.
+	std::size_t runs = 0;             // Number of counted runs.
+	double allocations = 0.0;         // Heap allocations over all runs.
+
+	// Mean heap allocations per run.
+	double allocationsPerRun() const { return runs ? allocations/runs : 0.0; }
+
+	bool any() const { return std::find(valid, valid + PERF_EVENTS, true) != valid + PERF_EVENTS; }
+
+	// Mean count per run per element, or a negative value if not counted.
+	double perElement(int e, long long n) const { return (valid[e] && runs && n) ? count[e]/runs/n : -1.0; }
+
+	// Instructions per cycle, or a negative value if not counted.
+	double ipc() const
+	{
+		return (valid[CYCLES] && valid[INSTRUCTIONS] && count[CYCLES] > 0.0) ? count[INSTRUCTIONS]/count[CYCLES] : -1.0;
+	}
+};
+
+#if defined(__linux__)
+// Set of perf_event counters measuring the calling thread.
+class PerfCounters
+{
+public:
+	PerfCounters()
+	{
+		const struct { uint32_t type; uint64_t config; } events[PERF_EVENTS] = {
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+		};
+
+		for (int e = 0; e < PERF_EVENTS; e++)
+		{
+			struct perf_event_attr attr;
+
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = events[e].type;
+			attr.config = events[e].config;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.inherit = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			fd[e] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+	}
+
+	~PerfCounters()
+	{
+		for (int e = 0; e < PERF_EVENTS; e++)
+			if (fd[e] >= 0)
+				close(fd[e]);
+	}
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator= (const PerfCounters&) = delete;
+
+	// True if at least one event can be counted.
+	bool available() const { return std::any_of(fd, fd + PERF_EVENTS, [](int f) { return f >= 0; }); }
+
+	// Zero and enable all counters.
+	void start()
+	{
+		for (int e = 0; e < PERF_EVENTS; e++)
+			if (fd[e] >= 0)
+			{
+				ioctl(fd[e], PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd[e], PERF_EVENT_IOC_ENABLE, 0);
+			}
+	}
+
+	// Disable all counters.
+	void stop()
+	{
+		for (int e = 0; e < PERF_EVENTS; e++)
+			if (fd[e] >= 0)
+				ioctl(fd[e], PERF_EVENT_IOC_DISABLE, 0);
+	}
+
+	// Adds the counts since start() to totals (runs are counted by the caller).
+	void accumulate(PerfTotals& totals) const
+	{
+		for (int e = 0; e < PERF_EVENTS; e++)
+		{
+			uint64_t v[3] = {}; // value, time enabled, time running
+
+			if (fd[e] < 0 || ::read(fd[e], v, sizeof(v)) != sizeof(v) || v[2] == 0)
+				continue;
+
+			totals.valid[e] = true;
+			totals.count[e] += double(v[0])*(double(v[1])/double(v[2]));
+		}
+	}
+
+private:
+	int fd[PERF_EVENTS];
+};
+#else
+// Counters are not supported on this platform.
+class PerfCounters
+{
+public:
+	bool available() const { return false; }
+	void start() { }
+	void stop() { }
+	void accumulate(PerfTotals&) const { }
+};
+#endif
+
+#endif
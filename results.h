@@ -0,0 +1,172 @@
+/*************************************************************************
+* Title: Benchmark Results Output.
+* File: results.h
+* Date: 10/16/2026
+*
+* Machine-readable benchmark results:
+*   one row per (algorithm, type, order, n) cell (ResultRow)
+*   least-squares complexity exponent fit (fitExponents)
+*   CSV and JSON writers (writeCsv, writeJson)
+*
+* Notes:
+*  (1) Bytes moved is the nominal traffic of reading and writing every
+*      element once (2 * n * sizeof(T)); multi-pass kernels move more.
+*  (2) The exponent is the slope of log(median time) against log(n) over
+*      all sizes of the same (algorithm, type, order) series, so O(n) fits
+*      near 1.0, O(n log n) slightly above 1.0 and O(n^2) near 2.0.
+*  (3) Hardware counter columns are per element per trial; they are empty
+*      (CSV) or null (JSON) when counters were not requested or available.
+*  (4) Load imbalance (busiest pool thread's busy time over the mean) is
+*      empty or null for sorts that do not run on the sort thread pool.
+*  (5) Sorts per second is filled in only by the tiny sorts sweep, which
+*      sorts the n keys as arrays of sortSize keys.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Add sorts per second column.
+*   10/16/2026: Add load imbalance column.
+*   10/16/2026: Add allocations per call column.
+*   10/16/2026: Add hardware counter columns.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _RESULTS_H_
+#define _RESULTS_H_
+
+// One benchmark cell.
+struct ResultRow
+{
+	std::string algorithm;    // Sort policy name.
+	std::string type;         // Element type name.
+	std::string order;        // Input distribution name.
+	long long n = 0;          // Number of elements.
+	std::size_t elemSize = 0; // sizeof(element).
+	BenchStats stats;         // Timing statistics (ms).
+	double exponent = 0.0;    // Fitted complexity exponent of the series.
+	double imbalance = -1.0;  // Sort pool max/mean busy time; negative if unused.
+	long long sortSize = 0;   // Keys per sort of a tiny sorts sweep; 0 for one sort of n.
+
+	double nsPerElement() const { return n ? stats.median*1.0e6/n : 0.0; }
+	double elementsPerSec() const { return stats.median > 0.0 ? n/(stats.median/1000.0) : 0.0; }
+	double bytesMoved() const { return 2.0*n*elemSize; }
+	double sortsPerSec() const { return (sortSize && stats.median > 0.0) ? ((n + sortSize - 1)/sortSize)/(stats.median/1000.0) : 0.0; }
+};
+
+// Fits log(median) = a + b*log(n) per series and stores b in each row.
+inline void fitExponents(std::vector<ResultRow>& rows)
+{
+	for (std::size_t i = 0; i < rows.size(); i++)
+	{
+		double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+		std::size_t k = 0;
+
+		for (const ResultRow& r : rows)
+		{
+			if (r.algorithm != rows[i].algorithm || r.type != rows[i].type || r.order != rows[i].order)
+				continue;
+
+			if (r.n <= 0 || r.stats.median <= 0.0)
+				continue;
+
+			const double x = std::log(double(r.n)), y = std::log(r.stats.median);
+			sx += x; sy += y; sxx += x*x; sxy += x*y;
+			k++;
+		}
+
+		const double den = k*sxx - sx*sx;
+		rows[i].exponent = (k > 1 && den != 0.0) ? (k*sxy - sx*sy)/den : 0.0;
+	}
+}
+
+// Writes rows as CSV with a header line.
+inline void writeCsv(std::ostream& os, const std::vector<ResultRow>& rows)
+{
+	os << "algorithm,type,order,n,trials,min_ms,median_ms,p95_ms,mean_ms,stddev_ms,"
+		"ns_per_element,elements_per_sec,bytes_moved,exponent,allocs_per_call,load_imbalance,sorts_per_sec,ipc";
+	for (int e = 0; e < PERF_EVENTS; e++)
+		os << ',' << perfEventName(e) << "_per_element";
+	os << '\n';
+
+	for (const ResultRow& r : rows)
+	{
+		os << r.algorithm << ',' << r.type << ',' << r.order << ',' << r.n << ','
+			<< r.stats.trials << ',' << r.stats.min << ',' << r.stats.median << ','
+			<< r.stats.p95 << ',' << r.stats.mean << ',' << r.stats.stddev << ','
+			<< r.nsPerElement() << ',' << r.elementsPerSec() << ',' << r.bytesMoved() << ','
+			<< r.exponent << ',' << r.stats.perf.allocationsPerRun() << ',';
+
+		// Sorts that did not use the thread pool have no load figure.
+		if (r.imbalance >= 0.0)
+			os << r.imbalance;
+		os << ',';
+
+		// Only tiny sorts sweeps count sorts.
+		if (r.sortSize)
+			os << r.sortsPerSec();
+		os << ',';
+
+		// Counters that were not read are left empty.
+		if (r.stats.perf.ipc() >= 0.0)
+			os << r.stats.perf.ipc();
+		for (int e = 0; e < PERF_EVENTS; e++)
+		{
+			os << ',';
+			if (r.stats.perf.valid[e])
+				os << r.stats.perf.perElement(e, r.n);
+		}
+		os << '\n';
+	}
+}
+
+// Writes rows as a JSON array of objects.
+inline void writeJson(std::ostream& os, const std::vector<ResultRow>& rows)
+{
+	os << "[\n";
+
+	for (std::size_t i = 0; i < rows.size(); i++)
+	{
+		const ResultRow& r = rows[i];
+
+		os << "  {\"algorithm\": \"" << r.algorithm << "\", \"type\": \"" << r.type
+			<< "\", \"order\": \"" << r.order << "\", \"n\": " << r.n
+			<< ", \"trials\": " << r.stats.trials << ", \"min_ms\": " << r.stats.min
+			<< ", \"median_ms\": " << r.stats.median << ", \"p95_ms\": " << r.stats.p95
+			<< ", \"mean_ms\": " << r.stats.mean << ", \"stddev_ms\": " << r.stats.stddev
+			<< ", \"ns_per_element\": " << r.nsPerElement()
+			<< ", \"elements_per_sec\": " << r.elementsPerSec()
+			<< ", \"bytes_moved\": " << r.bytesMoved()
+			<< ", \"exponent\": " << r.exponent
+			<< ", \"allocs_per_call\": " << r.stats.perf.allocationsPerRun();
+
+		os << ", \"load_imbalance\": ";
+		if (r.imbalance >= 0.0)
+			os << r.imbalance;
+		else
+			os << "null";
+
+		os << ", \"sorts_per_sec\": ";
+		if (r.sortSize)
+			os << r.sortsPerSec();
+		else
+			os << "null";
+
+		// Counters that were not read are null.
+		os << ", \"ipc\": ";
+		if (r.stats.perf.ipc() >= 0.0)
+			os << r.stats.perf.ipc();
+		else
+			os << "null";
+		for (int e = 0; e < PERF_EVENTS; e++)
+		{
+			os << ", \"" << perfEventName(e) << "_per_element\": ";
+			if (r.stats.perf.valid[e])
+				os << r.stats.perf.perElement(e, r.n);
+			else
+				os << "null";
+		}
+
+		os << "}" << (i + 1 < rows.size() ? "," : "") << "\n";
+	}
+
+	os << "]\n";
+}
+
+#endif
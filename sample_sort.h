@@ -0,0 +1,361 @@
+/*************************************************************************
+* Title: Parallel Sample Sort.
+* File: sample_sort.h
+* Date: 10/16/2026
+*
+* Parallel super scalar sample sort (after IPS4o and Sanders & Winkel's
+* super scalar sample sort) on the work-stealing sort pool (sampleSort):
+*   splitter selection and branchless classifier (SampleClassifier)
+*   bucket distribution of one range (sampleDistribute)
+*   recursive bucket tasks (sampleSortTask)
+*
+* Notes:
+*  (1) Each level picks up to 255 splitters from a sorted random sample
+*      and classifies keys by descending an implicit search tree with a
+*      comparison per level and no branches, four keys at a time.
+*  (2) Splitters that occur more than once enable equality buckets: keys
+*      equal to a splitter go to their own bucket, which is not sorted
+*      further, so inputs with many duplicates still split evenly.
+*  (3) The top level classifies and scatters in parallel stripes; the
+*      resulting buckets, and all deeper levels, run as tasks that steal
+*      work from each other.  Ranges of at most SAMPLE_BASE keys are
+*      finished with quickSort.
+*  (4) Unlike IPS4o's in-place block permutation, buckets are scattered
+*      into a buffer of n keys; levels alternate between the input and
+*      the buffer, and a range is copied back only at its leaf.  Bucket
+*      numbers are kept in a byte per key (the oracle), so keys are
+*      classified only once per level.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Overload taking the thread pool to run on.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _SAMPLE_SORT_H_
+#define _SAMPLE_SORT_H_
+
+constexpr int SAMPLE_LOG_BUCKETS{ 8 };                   // log2 of the most buckets per level.
+constexpr std::size_t SAMPLE_OVERSAMPLING{ 16 };         // Sample keys per bucket.
+constexpr std::size_t SAMPLE_BASE{ std::size_t(1) << 12 };    // Ranges this small use quickSort.
+constexpr std::size_t SAMPLE_STRIPE{ std::size_t(1) << 16 };  // Smallest top-level stripe.
+constexpr int SAMPLE_MAX_LEVELS{ 8 };                    // Deeper ranges use quickSort.
+
+/*************************************************************************
+ * Splitters of one level and the search tree classifying keys by them.
+ *************************************************************************/
+template <typename T>
+class SampleClassifier
+{
+public:
+	// Chooses splitters for the n keys at a (n > SAMPLE_BASE), sampling
+	// with rng state seed.
+	void build(const T* a, std::size_t n, uint64_t seed)
+	{
+		// Enough buckets for SAMPLE_BASE keys each, at most 2^SAMPLE_LOG_BUCKETS.
+		int logK = 1;
+		while (logK < SAMPLE_LOG_BUCKETS && (n >> (logK + 1)) >= SAMPLE_BASE)
+			logK++;
+
+		const std::size_t k = std::size_t(1) << logK;
+		const std::size_t s = std::min(n, k*SAMPLE_OVERSAMPLING);
+		std::vector<T> sample(s);
+
+		for (std::size_t i = 0; i < s; i++)
+		{
+			// splitmix64 step.
+			uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27))*0x94D049BB133111EBull;
+			sample[i] = a[(z ^ (z >> 31)) % n];
+		}
+
+		quickSort(sample.data(), sample.data() + s);
+
+		// Every (s/k)-th sample key, without repeats.
+		std::vector<T> split;
+		for (std::size_t i = 1; i < k; i++)
+		{
+			const T& x = sample[i*s/k - 1];
+
+			if (split.empty() || split.back() < x)
+				split.push_back(x);
+		}
+
+		equal = (split.size() < k - 1);
+
+		// Equality buckets double the bucket count; keep it within a byte.
+		if (equal)
+			while (split.size() > 127)
+			{
+				std::size_t j = 0;
+				for (std::size_t i = 1; i < split.size(); i += 2)
+					split[j++] = split[i];
+				split.resize(j);
+			}
+
+		logBuckets = 1;
+		while ((std::size_t(1) << logBuckets) < split.size() + 1)
+			logBuckets++;
+
+		buckets = std::size_t(1) << logBuckets;
+
+		// Pad with the largest splitter; the extra buckets stay empty.
+		split.resize(buckets, split.back());
+		std::copy(split.begin(), split.end(), splitters);
+		fillTree(1, 0, buckets - 1);
+	}
+
+	// Number of buckets, counting equality buckets.
+	std::size_t size() const { return equal ? 2*buckets : buckets; }
+
+	// True if bucket b holds keys equal to one splitter only.
+	bool isEqualBucket(std::size_t b) const { return equal && (b & 1); }
+
+	// Bucket of each of the n keys at a, written to out.
+	void classify(const T* a, std::size_t n, uint8_t* out) const
+	{
+		std::size_t i = 0;
+
+		// Four independent descents keep the comparisons in flight.
+		for (; i + 4 <= n; i += 4)
+		{
+			std::size_t b0 = 1, b1 = 1, b2 = 1, b3 = 1;
+
+			for (int l = 0; l < logBuckets; l++)
+			{
+				b0 = 2*b0 + (tree[b0] < a[i]);
+				b1 = 2*b1 + (tree[b1] < a[i + 1]);
+				b2 = 2*b2 + (tree[b2] < a[i + 2]);
+				b3 = 2*b3 + (tree[b3] < a[i + 3]);
+			}
+
+			out[i] = finish(b0, a[i]);
+			out[i + 1] = finish(b1, a[i + 1]);
+			out[i + 2] = finish(b2, a[i + 2]);
+			out[i + 3] = finish(b3, a[i + 3]);
+		}
+
+		for (; i < n; i++)
+		{
+			std::size_t b = 1;
+
+			for (int l = 0; l < logBuckets; l++)
+				b = 2*b + (tree[b] < a[i]);
+
+			out[i] = finish(b, a[i]);
+		}
+	}
+
+private:
+	// Stores the splitters [lo, hi) in the subtree rooted at node.
+	void fillTree(std::size_t node, std::size_t lo, std::size_t hi)
+	{
+		if (lo >= hi)
+			return;
+
+		const std::size_t mid = lo + (hi - lo)/2;
+
+		tree[node] = splitters[mid];
+		fillTree(2*node, lo, mid);
+		fillTree(2*node + 1, mid + 1, hi);
+	}
+
+	// Bucket of key from its leaf b; leaf i holds keys in
+	// (splitters[i-1], splitters[i]] and, with equality buckets, those
+	// equal to splitters[i] go to bucket 2i+1.  The last leaf has no
+	// upper splitter.
+	uint8_t finish(std::size_t b, const T& key) const
+	{
+		b -= buckets;
+
+		return uint8_t(equal ? 2*b + (b + 1 < buckets && !(key < splitters[b])) : b);
+	}
+
+	T tree[std::size_t(1) << SAMPLE_LOG_BUCKETS];       // Implicit search tree, root at 1.
+	T splitters[std::size_t(1) << SAMPLE_LOG_BUCKETS];  // Sorted, last one repeated.
+	std::size_t buckets = 2;                            // Leaves of the tree.
+	int logBuckets = 1;                                 // Tree depth.
+	bool equal = false;                                 // Equality buckets enabled.
+};
+
+/*************************************************************************
+ * Classifies the n keys at src and scatters them into dst by bucket.
+ * start receives the first position of each bucket, plus n at the end.
+ *************************************************************************/
+template <typename T>
+void sampleDistribute(const SampleClassifier<T>& c, const T* src, T* dst, uint8_t* oracle, std::size_t n, std::size_t* start)
+{
+	const std::size_t k = c.size();
+	std::size_t pos[2 << SAMPLE_LOG_BUCKETS] = { };
+
+	c.classify(src, n, oracle);
+
+	for (std::size_t i = 0; i < n; i++)
+		pos[oracle[i]]++;
+
+	for (std::size_t b = 0, sum = 0; b < k; b++)
+	{
+		start[b] = sum;
+		sum += pos[b];
+		pos[b] = start[b];
+	}
+	start[k] = n;
+
+	for (std::size_t i = 0; i < n; i++)
+		dst[pos[oracle[i]]++] = src[i];
+}
+
+/*************************************************************************
+ * Sorts the n keys of range a, currently held in a (inTmp false) or at
+ * the same offset of the buffer tmp (inTmp true), leaving them in a.
+ *************************************************************************/
+template <typename T>
+void sampleSortTask(ThreadPool& pool, unsigned worker, T* a, T* tmp, uint8_t* oracle, std::size_t n, bool inTmp, int level)
+{
+	pool.addWork(worker, n);
+
+	if (n <= SAMPLE_BASE || level >= SAMPLE_MAX_LEVELS)
+	{
+		if (inTmp)
+			std::copy(tmp, tmp + n, a);
+
+		quickSort(a, a + n);
+		return;
+	}
+
+	const T* src = inTmp ? tmp : a;
+	T* dst = inTmp ? a : tmp;
+	SampleClassifier<T> c;
+	std::size_t start[(2 << SAMPLE_LOG_BUCKETS) + 1];
+
+	c.build(src, n, uint64_t(n)*0x2545F4914F6CDD1Dull + level);
+	sampleDistribute(c, src, dst, oracle, n, start);
+
+	// Large buckets become tasks; small ones are sorted here afterwards,
+	// while other workers steal the large ones.
+	for (std::size_t b = 0; b < c.size(); b++)
+	{
+		const std::size_t lo = start[b], m = start[b + 1] - lo;
+
+		if (m == 0)
+			continue;
+
+		if (c.isEqualBucket(b))
+		{
+			if (dst != a)
+				std::copy(dst + lo, dst + lo + m, a + lo);
+		}
+		else if (m > SAMPLE_BASE)
+		{
+			// A bucket holding everything means the sample could not split
+			// the keys; stop recursing.
+			const int next = (m == n) ? SAMPLE_MAX_LEVELS : level + 1;
+
+			pool.spawn([&pool, a, tmp, oracle, lo, m, inTmp, next](unsigned w) {
+				sampleSortTask(pool, w, a + lo, tmp + lo, oracle + lo, m, !inTmp, next);
+			});
+		}
+	}
+
+	for (std::size_t b = 0; b < c.size(); b++)
+	{
+		const std::size_t lo = start[b], m = start[b + 1] - lo;
+
+		if (m == 0 || m > SAMPLE_BASE || c.isEqualBucket(b))
+			continue;
+
+		if (dst != a)
+			std::copy(dst + lo, dst + lo + m, a + lo);
+
+		quickSort(a + lo, a + lo + m);
+	}
+}
+
+/*************************************************************************
+ * Parallel sample sort on pool.  The first level runs in
+ * parallel stripes: classification with per-stripe bucket counts, a
+ * prefix sum in (bucket, stripe) order, then scattering into disjoint
+ * slices of the buffer.  The buckets are then sorted as stealable tasks.
+ *************************************************************************/
+template <typename T>
+void sampleSort(T* begin, T* end, ThreadPool& pool)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if (n <= SAMPLE_BASE)
+	{
+		quickSort(begin, end);
+		return;
+	}
+
+	std::unique_ptr<T[]> tmp(new T[n]);
+	std::unique_ptr<uint8_t[]> oracle(new uint8_t[n]);
+	const std::size_t stripes = std::min<std::size_t>(4*pool.size(), n/SAMPLE_STRIPE);
+
+	// Too small to split: one task does the whole first level.
+	if (stripes < 2)
+	{
+		pool.run([&](unsigned w) { sampleSortTask(pool, w, begin, tmp.get(), oracle.get(), n, false, 0); });
+		return;
+	}
+
+	SampleClassifier<T> c;
+	c.build(begin, n, uint64_t(n)*0x2545F4914F6CDD1Dull);
+
+	std::vector<std::vector<std::size_t>> count(stripes, std::vector<std::size_t>(c.size(), 0));
+	auto first = [&](std::size_t s) { return n*s/stripes; };
+
+	pool.parallelFor(stripes, [&](std::size_t s, unsigned w) {
+		const std::size_t lo = first(s), hi = first(s + 1);
+
+		c.classify(begin + lo, hi - lo, oracle.get() + lo);
+		for (std::size_t i = lo; i < hi; i++)
+			count[s][oracle[i]]++;
+		pool.addWork(w, hi - lo);
+	});
+
+	std::vector<std::size_t> start(c.size() + 1, n);
+	for (std::size_t b = 0, pos = 0; b < c.size(); b++)
+	{
+		start[b] = pos;
+		for (std::size_t s = 0; s < stripes; s++)
+		{
+			const std::size_t m = count[s][b];
+			count[s][b] = pos;
+			pos += m;
+		}
+	}
+
+	pool.parallelFor(stripes, [&](std::size_t s, unsigned w) {
+		std::vector<std::size_t>& pos = count[s];
+
+		for (std::size_t i = first(s), hi = first(s + 1); i < hi; i++)
+			tmp[pos[oracle[i]]++] = begin[i];
+		pool.addWork(w, first(s + 1) - first(s));
+	});
+
+	// Equality buckets only move back; the rest are sorted as tasks.
+	pool.run([&](unsigned) {
+		for (std::size_t b = 0; b < c.size(); b++)
+		{
+			const std::size_t lo = start[b], m = start[b + 1] - lo;
+
+			if (m == 0)
+				continue;
+
+			const bool equal = c.isEqualBucket(b);
+
+			pool.spawn([&, lo, m, equal](unsigned w) {
+				if (equal)
+					std::copy(tmp.get() + lo, tmp.get() + lo + m, begin + lo);
+				else
+					sampleSortTask(pool, w, begin + lo, tmp.get() + lo, oracle.get() + lo, m, true, 1);
+			});
+		}
+	});
+}
+
+// Parallel sample sort policy on the shared sort pool.
+template <typename T>
+void sampleSort(T* begin, T* end) { sampleSort(begin, end, sortPool()); }
+
+#endif
@@ -0,0 +1,130 @@
+/*************************************************************************
+* Title: Scratch Arena.
+* File: scratch_arena.h
+* Date: 10/16/2026
+*
+* Caller-owned scratch memory reused across sorts (ScratchArena), and a
+* per-thread arena for the arena-backed sort policies (threadArena).
+*
+* Notes:
+*  (1) The arena only grows, to at least double its capacity, so sizes
+*      creeping upward reallocate only a logarithmic number of times;
+*      once it is large enough, repeated sorts of the same or smaller size
+*      make no heap allocations.
+*  (2) On Linux memory is mapped with mmap.  Optionally it is advised for
+*      transparent huge pages and pre-faulted, so the first sort does not
+*      pay for page faults.  Elsewhere it comes from malloc.
+*  (3) Scratch memory is uninitialized storage; only trivially copyable
+*      element types may be placed in it.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Fix growth to double the capacity.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _SCRATCH_ARENA_H_
+#define _SCRATCH_ARENA_H_
+
+class ScratchArena
+{
+public:
+	ScratchArena() = default;
+
+	// Reserves bytes up front, optionally huge-page backed and pre-faulted.
+	explicit ScratchArena(std::size_t bytes, bool hugePages = false, bool prefault = false)
+		: hugePages(hugePages), prefault(prefault)
+	{
+		reserve(bytes);
+	}
+
+	~ScratchArena() { release(); }
+
+	ScratchArena(const ScratchArena&) = delete;
+	ScratchArena& operator= (const ScratchArena&) = delete;
+
+	// Returns at least bytes of scratch memory, growing the arena if needed.
+	// Previous contents are not preserved across growth.
+	void* reserve(std::size_t bytes)
+	{
+		if (bytes > size)
+		{
+			const std::size_t grown = std::max(bytes, 2*size);
+
+			release();
+			allocate(grown);
+		}
+
+		return base;
+	}
+
+	// Returns scratch storage for n elements of type T.
+	template <typename T>
+	T* get(std::size_t n)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "scratch arena holds trivially copyable types only");
+
+		return static_cast<T*>(reserve(n*sizeof(T)));
+	}
+
+	std::size_t capacity() const { return size; }
+
+private:
+	void allocate(std::size_t bytes)
+	{
+		// Round up to whole (huge) pages.
+		const std::size_t page = hugePages ? (std::size_t(2) << 20) : 4096;
+		bytes = (bytes + page - 1)/page*page;
+
+#if defined(__linux__)
+		void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (p == MAP_FAILED)
+			throw std::bad_alloc();
+
+		if (hugePages)
+			madvise(p, bytes, MADV_HUGEPAGE);
+#else
+		void* p = std::malloc(bytes);
+
+		if (!p)
+			throw std::bad_alloc();
+#endif
+		allocationCount++;
+
+		// Touch every page now rather than on first use.
+		if (prefault)
+			for (std::size_t i = 0; i < bytes; i += 4096)
+				static_cast<volatile char*>(p)[i] = 0;
+
+		base = p;
+		size = bytes;
+	}
+
+	void release()
+	{
+		if (!base)
+			return;
+
+#if defined(__linux__)
+		munmap(base, size);
+#else
+		std::free(base);
+#endif
+		base = nullptr;
+		size = 0;
+	}
+
+	void* base = nullptr;    // Start of scratch memory.
+	std::size_t size = 0;    // Capacity in bytes.
+	bool hugePages = false;  // Advise transparent huge pages.
+	bool prefault = false;   // Touch pages on allocation.
+};
+
+// Scratch arena owned by the calling thread.
+inline ScratchArena& threadArena()
+{
+	thread_local ScratchArena arena;
+
+	return arena;
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*************************************************************************
+* Title: Segmented Sort.
+* File: segmented_sort.h
+* Date: 10/16/2026
+*
+* Sorts many independent segments of one key buffer, segment i being
+* keys[offsets[i], offsets[i + 1]):
+*   parallel sort of each segment by its size class (segmentedSort)
+*   one radix sort of (segment, key) pairs (segmentedSortGlobal)
+*   generated segment layouts for benchmarks (segmentOffsets)
+*
+* Notes:
+*  (1) segmentedSort splits the keys into equal shares, and a pool task
+*      sorts the segments starting in its share.  Each segment is sorted
+*      by size class: tinySort (sorting networks) up to TINY_SORT_MAX
+*      keys, quickSort below the auto sort radix limit, and radixSort
+*      with the worker's scratch arena above it, so no segment allocates
+*      once the arenas have grown.
+*  (2) A segment of at least SEGMENT_HUGE keys and n/(8 threads) keys is
+*      left out of the tasks and sorted afterwards by sampleSort on the
+*      whole pool, so one giant segment in a skewed layout does not leave
+*      the other threads idle.  A single-thread pool sorts it in its task.
+*  (3) segmentedSortGlobal tags every key with its segment number and LSD
+*      radix sorts the pairs by key, then (stably) by segment.  The passes
+*      over the segment numbers skip digits that are the same for every
+*      pair, so fewer than 256 segments cost one extra pass.  Its cost
+*      does not depend on the segment lengths; it is sequential except
+*      for tagging and copying back.
+*  (4) Offsets are non-decreasing indices into keys; empty segments are
+*      allowed.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _SEGMENTED_SORT_H_
+#define _SEGMENTED_SORT_H_
+
+constexpr std::size_t SEGMENT_SHARE{ std::size_t(1) << 15 };  // Smallest share of keys per task.
+constexpr std::size_t SEGMENT_TASKS{ 8 };                     // Tasks per pool thread, for stealing.
+constexpr std::size_t SEGMENT_HUGE{ std::size_t(1) << 18 };   // Smallest segment sorted by the whole pool.
+
+// Sorts one segment with the kernel of its size class.
+template <typename T>
+void sortSegment(T* begin, T* end)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if (n <= TINY_SORT_MAX)
+		tinySort(begin, end, std::less<T>());
+	else if (n < autoSortTuning<T>().radixMin)
+		quickSort(begin, end);
+	else
+		radixSort(begin, end, threadArena());
+}
+
+/*************************************************************************
+ * Sorts the segments [offsets[i], offsets[i + 1]) of keys, i < segments,
+ * in parallel on pool.
+ *************************************************************************/
+template <typename T, typename O>
+void segmentedSort(T* keys, const O* offsets, std::size_t segments, ThreadPool& pool)
+{
+	if (!segments)
+		return;
+
+	const std::size_t first = offsets[0], n = offsets[segments] - offsets[0];
+	const std::size_t parts = std::max<std::size_t>(1, std::min(pool.size()*SEGMENT_TASKS, n/SEGMENT_SHARE));
+	const std::size_t huge = (pool.size() > 1) ? std::max(SEGMENT_HUGE, n/(8*pool.size())) : SIZE_MAX;
+	std::vector<std::vector<std::size_t>> hugeSegments(parts);
+
+	// Part p sorts the segments that start in its share of the keys.
+	pool.parallelFor(parts, [&](std::size_t p, unsigned w) {
+		const O* s = std::lower_bound(offsets, offsets + segments, O(first + n*p/parts));
+		const O* e = std::lower_bound(offsets, offsets + segments, O(first + n*(p + 1)/parts));
+
+		std::size_t sorted = 0;
+
+		for (; s != e; ++s)
+		{
+			const std::size_t length = s[1] - s[0];
+
+			if (length >= huge)
+				hugeSegments[p].push_back(s - offsets);
+			else
+			{
+				sortSegment(keys + s[0], keys + s[1]);
+				sorted += length;
+			}
+		}
+
+		pool.addWork(w, sorted);
+	});
+
+	for (const std::vector<std::size_t>& part : hugeSegments)
+		for (std::size_t i : part)
+			sampleSort(keys + offsets[i], keys + offsets[i + 1], pool);
+}
+
+template <typename T, typename O>
+void segmentedSort(T* keys, const O* offsets, std::size_t segments) { segmentedSort(keys, offsets, segments, sortPool()); }
+
+/*************************************************************************
+ * Sorts the segments with one radix sort of (segment, key) pairs.
+ *************************************************************************/
+template <typename T, typename O>
+void segmentedSortGlobal(T* keys, const O* offsets, std::size_t segments, ThreadPool& pool)
+{
+	typedef typename std::make_unsigned<O>::type S;
+	struct Tagged { S segment; T key; };
+
+	if (!segments)
+		return;
+
+	const std::size_t first = offsets[0], n = offsets[segments] - offsets[0];
+	const std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(pool.size(), segments));
+	std::unique_ptr<Tagged[]> tagged(new Tagged[n]), buffer(new Tagged[n]);
+
+	pool.parallelFor(parts, [&](std::size_t p, unsigned) {
+		for (std::size_t i = segments*p/parts; i < segments*(p + 1)/parts; i++)
+			for (std::size_t k = offsets[i]; k < std::size_t(offsets[i + 1]); k++)
+				tagged[k - first] = Tagged{ S(i), keys[k] };
+	});
+
+	radixSortKeyed(tagged.get(), tagged.get() + n, buffer.get(), [](const Tagged& x) { return radixKey(x.key); });
+	radixSortKeyed(tagged.get(), tagged.get() + n, buffer.get(), [](const Tagged& x) { return x.segment; });
+
+	pool.parallelFor(parts, [&](std::size_t p, unsigned) {
+		for (std::size_t k = n*p/parts; k < n*(p + 1)/parts; k++)
+			keys[first + k] = tagged[k].key;
+	});
+}
+
+template <typename T, typename O>
+void segmentedSortGlobal(T* keys, const O* offsets, std::size_t segments) { segmentedSortGlobal(keys, offsets, segments, sortPool()); }
+
+/*************************************************************************
+ * Generated segment layouts.
+ *************************************************************************/
+enum SegmentShape { SEGMENT_UNIFORM, SEGMENT_POWER, SEGMENT_ONE_BIG };
+
+inline const char* segmentShapeName(SegmentShape shape)
+{
+	switch (shape)
+	{
+		case SEGMENT_POWER:   return "power";
+		case SEGMENT_ONE_BIG: return "one_big";
+		case SEGMENT_UNIFORM:
+		default:              return "uniform";
+	}
+}
+
+constexpr double SEGMENT_POWER_ALPHA{ 1.2 }; // Pareto shape of power segment lengths.
+
+// Offsets of segments covering n keys with lengths of the given shape and
+// about the given mean: uniform in [1, 2 mean - 1], Pareto (a few very
+// long segments among many short ones), or uniform after one segment of
+// half the keys.  The last segment is cut to end at n.
+inline std::vector<std::size_t> segmentOffsets(std::size_t n, SegmentShape shape, std::size_t mean, uint64_t seed)
+{
+	const uint64_t key = splitmix64(seed ^ 0x5e6d3e47ULL);
+	const double xmin = std::max(1.0, double(mean)*(SEGMENT_POWER_ALPHA - 1.0)/SEGMENT_POWER_ALPHA);
+	std::vector<std::size_t> offsets{ 0 };
+
+	mean = std::max<std::size_t>(mean, 1);
+
+	if (shape == SEGMENT_ONE_BIG && n)
+		offsets.push_back(n/2);
+
+	for (std::size_t i = 0; offsets.back() < n; i++)
+	{
+		const uint64_t r = counterRandom(key, i);
+		std::size_t length;
+
+		if (shape == SEGMENT_POWER)
+		{
+			const double u = double((r >> 11) + 1)*0x1.0p-53;
+			length = std::size_t(std::min(double(n), xmin*std::pow(u, -1.0/SEGMENT_POWER_ALPHA)));
+		}
+		else
+			length = 1 + std::size_t(randomBelow(r, 2*mean - 1));
+
+		offsets.push_back(std::min(n, offsets.back() + length));
+	}
+
+	return offsets;
+}
+
+#endif
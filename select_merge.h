@@ -0,0 +1,448 @@
+/*************************************************************************
+* Title: Parallel Selection and Multiway Merge.
+* File: select_merge.h
+* Date: 10/16/2026
+*
+* Partial sorting work on the shared sort pool:
+*   parallel selection, std::nth_element semantics (parallelNthElement)
+*   parallel top-k, std::partial_sort semantics (parallelPartialSort)
+*   k-th smallest key by bounded heaps or radix select (heapSelect,
+*   radixSelect)
+*   sequential and parallel k-way merge of sorted runs (multiwayMerge,
+*   parallelMultiwayMerge)
+*
+* Notes:
+*  (1) Selection first finds the key v of the requested rank, then moves
+*      the keys less than, equal to and greater than v to their places.
+*      For small ranks a parallel scan finds the few keys that belong in
+*      front and swaps them there; otherwise one parallel three-way
+*      partition goes through a buffer.  Top-k is selection of rank k-1
+*      followed by sampleSort of the first k-1 keys.
+*  (2) When k (or n - k, from the other end) is at most SELECT_HEAP_MAX,
+*      every stripe keeps the k smallest keys it has seen in a max-heap,
+*      which most keys fail to enter after one comparison.  The merged
+*      heaps hold the answer.  Larger ranks use an MSD radix select over
+*      the radixKey digits: parallel histograms pick the digit bucket
+*      holding the rank, and only that bucket is copied on to the next
+*      digit.  Non-arithmetic keys use std::nth_element for large ranks.
+*  (3) The parallel merge splits the output into equal parts; the input
+*      positions where each part starts are found by a multi-sequence
+*      selection (binary search over candidate keys), and every part is
+*      merged independently with a loser tree.  Equal keys keep their run
+*      order, so the merge is stable.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _SELECT_MERGE_H_
+#define _SELECT_MERGE_H_
+
+constexpr std::size_t SELECT_HEAP_MAX{ std::size_t(1) << 12 }; // Largest rank selected with heaps.
+constexpr std::size_t SELECT_STRIPE{ std::size_t(1) << 16 };   // Smallest parallel stripe.
+constexpr std::size_t SELECT_SMALL{ std::size_t(1) << 14 };    // Inputs this small use the STL.
+
+// Sorted input runs of a merge, as [begin, end) pairs.
+template <typename T>
+using SortedRuns = std::vector<std::pair<const T*, const T*>>;
+
+// Parallel stripes for n keys on pool.
+inline std::size_t selectStripes(std::size_t n, const ThreadPool& pool)
+{
+	return std::max<std::size_t>(1, std::min<std::size_t>(4*pool.size(), n/SELECT_STRIPE));
+}
+
+/*************************************************************************
+ * Key of rank r (0-based) in the n keys at a under less, from bounded
+ * max-heaps of the r + 1 smallest keys of each stripe.
+ *************************************************************************/
+template <typename T, typename Compare>
+T heapSelect(const T* a, std::size_t n, std::size_t r, Compare less, ThreadPool& pool)
+{
+	const std::size_t stripes = selectStripes(n, pool), keep = r + 1;
+	std::vector<std::vector<T>> heaps(stripes);
+
+	pool.parallelFor(stripes, [&](std::size_t s, unsigned w) {
+		std::vector<T>& h = heaps[s];
+		const std::size_t lo = n*s/stripes, hi = n*(s + 1)/stripes;
+
+		h.reserve(keep);
+		for (std::size_t i = lo; i < hi; i++)
+			if (h.size() < keep)
+			{
+				h.push_back(a[i]);
+				std::push_heap(h.begin(), h.end(), less);
+			}
+			else if (less(a[i], h.front()))
+			{
+				std::pop_heap(h.begin(), h.end(), less);
+				h.back() = a[i];
+				std::push_heap(h.begin(), h.end(), less);
+			}
+
+		pool.addWork(w, hi - lo);
+	});
+
+	std::vector<T> candidates;
+	for (const std::vector<T>& h : heaps)
+		candidates.insert(candidates.end(), h.begin(), h.end());
+
+	std::nth_element(candidates.begin(), candidates.begin() + r, candidates.end(), less);
+
+	return candidates[r];
+}
+
+/*************************************************************************
+ * Key of rank r (0-based) in the n keys at a, by MSD radix select on
+ * 8-bit digits of radixKey.
+ *************************************************************************/
+template <typename T>
+T radixSelect(const T* a, std::size_t n, std::size_t r, ThreadPool& pool)
+{
+	typedef typename radixBits<T>::type U;
+	constexpr std::size_t BUCKETS = 256;
+	typedef std::array<std::size_t, BUCKETS> Histogram;
+
+	std::vector<T> candidates, next;
+	const T* src = a;
+	std::size_t m = n;
+
+	for (int shift = 8*int(sizeof(U)) - 8; ; shift -= 8)
+	{
+		if (m <= SELECT_SMALL)
+		{
+			std::vector<T> rest(src, src + m);
+
+			std::nth_element(rest.begin(), rest.begin() + r, rest.end());
+			return rest[r];
+		}
+
+		const std::size_t stripes = selectStripes(m, pool);
+		std::vector<Histogram> count(stripes);
+		auto digit = [shift](const T& x) { return std::size_t(radixKey(x) >> shift) & (BUCKETS - 1); };
+
+		pool.parallelFor(stripes, [&](std::size_t s, unsigned w) {
+			const std::size_t lo = m*s/stripes, hi = m*(s + 1)/stripes;
+
+			count[s].fill(0);
+			for (std::size_t i = lo; i < hi; i++)
+				count[s][digit(src[i])]++;
+
+			pool.addWork(w, hi - lo);
+		});
+
+		// Bucket holding rank r, and r within it.
+		std::size_t b = 0, size = 0;
+		for (;; b++)
+		{
+			size = 0;
+			for (std::size_t s = 0; s < stripes; s++)
+				size += count[s][b];
+
+			if (r < size)
+				break;
+			r -= size;
+		}
+
+		// Keys left in the last digit's bucket are all equal.
+		if (shift == 0)
+			return *std::find_if(src, src + m, [&](const T& x) { return digit(x) == b; });
+
+		// A digit shared by every key narrows nothing.
+		if (size == m)
+			continue;
+
+		// Copy the bucket, each stripe to its own offset.
+		std::vector<std::size_t> offset(stripes);
+		for (std::size_t s = 0, pos = 0; s < stripes; s++)
+		{
+			offset[s] = pos;
+			pos += count[s][b];
+		}
+
+		next.resize(size);
+		pool.parallelFor(stripes, [&](std::size_t s, unsigned) {
+			T* out = next.data() + offset[s];
+
+			for (std::size_t i = m*s/stripes, hi = m*(s + 1)/stripes; i < hi; i++)
+				if (digit(src[i]) == b)
+					*out++ = src[i];
+		});
+
+		candidates.swap(next);
+		src = candidates.data();
+		m = size;
+	}
+}
+
+/*************************************************************************
+ * Moves the keys less than v to the front and those greater than v to
+ * the back, with those equal to v between them.
+ *************************************************************************/
+template <typename T>
+void selectPartition(T* a, std::size_t n, const T& v, ThreadPool& pool)
+{
+	const std::size_t stripes = selectStripes(n, pool);
+	std::vector<std::array<std::size_t, 3>> count(stripes);
+	std::unique_ptr<T[]> buffer(new T[n]);
+	auto part = [&v](const T& x) { return std::size_t(v < x) + std::size_t(!(x < v)); };
+
+	pool.parallelFor(stripes, [&](std::size_t s, unsigned w) {
+		count[s].fill(0);
+		for (std::size_t i = n*s/stripes, hi = n*(s + 1)/stripes; i < hi; i++)
+			count[s][part(a[i])]++;
+
+		pool.addWork(w, n*(s + 1)/stripes - n*s/stripes);
+	});
+
+	// Exclusive prefix sum in (part, stripe) order.
+	for (std::size_t p = 0, pos = 0; p < 3; p++)
+		for (std::size_t s = 0; s < stripes; s++)
+		{
+			const std::size_t c = count[s][p];
+			count[s][p] = pos;
+			pos += c;
+		}
+
+	pool.parallelFor(stripes, [&](std::size_t s, unsigned) {
+		std::array<std::size_t, 3>& pos = count[s];
+
+		for (std::size_t i = n*s/stripes, hi = n*(s + 1)/stripes; i < hi; i++)
+			buffer[pos[part(a[i])]++] = a[i];
+	});
+
+	pool.parallelFor(stripes, [&](std::size_t s, unsigned) {
+		std::copy(buffer.get() + n*s/stripes, buffer.get() + n*(s + 1)/stripes, a + n*s/stripes);
+	});
+}
+
+/*************************************************************************
+ * Moves the r + 1 keys first under less (v last of them, rank r) to the
+ * first r + 1 positions, or to the last r + 1 (in reverse) when back is
+ * set, by swapping only the keys that are out of place.
+ *************************************************************************/
+template <typename T, typename Compare>
+void selectGather(T* a, std::size_t n, std::size_t r, const T& v, Compare less, bool back, ThreadPool& pool)
+{
+	const std::size_t stripes = selectStripes(n, pool);
+	std::vector<std::vector<std::size_t>> before(stripes), equal(stripes);
+	auto at = [=](std::size_t p) -> T& { return back ? a[n - 1 - p] : a[p]; };
+
+	pool.parallelFor(stripes, [&](std::size_t s, unsigned w) {
+		for (std::size_t p = n*s/stripes, hi = n*(s + 1)/stripes; p < hi; p++)
+			if (less(at(p), v))
+				before[s].push_back(p);
+			else if (!less(v, at(p)) && equal[s].size() <= r)
+				equal[s].push_back(p);
+
+		pool.addWork(w, n*(s + 1)/stripes - n*s/stripes);
+	});
+
+	// Positions of the selected keys, in increasing order.
+	std::vector<std::size_t> wanted;
+	for (const std::vector<std::size_t>& b : before)
+		wanted.insert(wanted.end(), b.begin(), b.end());
+
+	for (std::size_t s = 0; s < stripes; s++)
+		for (std::size_t i = 0; i < equal[s].size() && wanted.size() <= r; i++)
+			wanted.push_back(equal[s][i]);
+
+	std::sort(wanted.begin(), wanted.end());
+
+	// Selected keys past r fill the unselected positions up to r.
+	std::vector<std::size_t>::const_iterator in = wanted.begin(), out = std::upper_bound(wanted.begin(), wanted.end(), r);
+
+	for (std::size_t p = 0; p <= r; p++)
+		if (in != wanted.end() && *in == p)
+			++in;
+		else
+			std::swap(at(p), at(*out++));
+
+	// Keys equal to v last among the selected.
+	if (back)
+		std::partition(a + n - 1 - r, a + n, [&](const T& x) { return !less(x, v); });
+	else
+		std::partition(a, a + r + 1, [&](const T& x) { return less(x, v); });
+}
+
+/*************************************************************************
+ * Parallel selection: *nth becomes the key sorted order puts there, no
+ * key before it is greater and none after it is less.
+ *************************************************************************/
+template <typename T>
+void parallelNthElement(T* begin, T* nth, T* end, ThreadPool& pool)
+{
+	const std::size_t n = std::distance(begin, end), r = std::distance(begin, nth);
+
+	if (r >= n)
+		return;
+
+	if (n <= SELECT_SMALL)
+	{
+		std::nth_element(begin, nth, end);
+		return;
+	}
+
+	if (r <= SELECT_HEAP_MAX)
+		selectGather(begin, n, r, heapSelect(begin, n, r, std::less<T>(), pool), std::less<T>(), false, pool);
+	else if (n - 1 - r <= SELECT_HEAP_MAX)
+		selectGather(begin, n, n - 1 - r, heapSelect(begin, n, n - 1 - r, std::greater<T>(), pool), std::greater<T>(), true, pool);
+	else if constexpr (std::is_arithmetic<T>::value)
+		selectPartition(begin, n, radixSelect(begin, n, r, pool), pool);
+	else
+		std::nth_element(begin, nth, end);
+}
+
+template <typename T>
+void parallelNthElement(T* begin, T* nth, T* end) { parallelNthElement(begin, nth, end, sortPool()); }
+
+/*************************************************************************
+ * Parallel top-k: the smallest middle - begin keys in sorted order at
+ * the front, the rest in unspecified order.
+ *************************************************************************/
+template <typename T>
+void parallelPartialSort(T* begin, T* middle, T* end, ThreadPool& pool)
+{
+	if (middle == begin)
+		return;
+
+	parallelNthElement(begin, middle - 1, end, pool);
+	sampleSort(begin, middle - 1, pool);
+}
+
+template <typename T>
+void parallelPartialSort(T* begin, T* middle, T* end) { parallelPartialSort(begin, middle, end, sortPool()); }
+
+/*************************************************************************
+ * Start position in each run of the first r keys of the stable merge of
+ * runs (r at most their total length).
+ *************************************************************************/
+template <typename T>
+std::vector<std::size_t> multiwaySplit(const SortedRuns<T>& runs, std::size_t r)
+{
+	const std::size_t k = runs.size();
+	std::vector<std::size_t> lo(k, 0), hi(k), split(k, 0);
+
+	for (std::size_t i = 0; i < k; i++)
+		hi[i] = runs[i].second - runs[i].first;
+
+	if (r == 0)
+		return split;
+
+	// Smallest key v with at least r keys <= v: binary search over the
+	// candidate keys [lo, hi) of all runs, halving the largest range.
+	const T* v = nullptr;
+
+	for (;;)
+	{
+		std::size_t widest = 0;
+		for (std::size_t i = 1; i < k; i++)
+			if (hi[i] - lo[i] > hi[widest] - lo[widest])
+				widest = i;
+
+		if (lo[widest] == hi[widest])
+			break;
+
+		const T* pivot = runs[widest].first + lo[widest] + (hi[widest] - lo[widest])/2;
+		std::size_t atMost = 0;
+
+		for (std::size_t i = 0; i < k; i++)
+			atMost += std::upper_bound(runs[i].first, runs[i].second, *pivot) - runs[i].first;
+
+		for (std::size_t i = 0; i < k; i++)
+			if (atMost >= r)
+				hi[i] = std::min<std::size_t>(hi[i], std::lower_bound(runs[i].first, runs[i].second, *pivot) - runs[i].first);
+			else
+				lo[i] = std::max<std::size_t>(lo[i], std::upper_bound(runs[i].first, runs[i].second, *pivot) - runs[i].first);
+
+		if (atMost >= r)
+			v = pivot;
+	}
+
+	// All keys below v, then keys equal to v in run order.
+	std::size_t need = r;
+
+	for (std::size_t i = 0; i < k; i++)
+	{
+		split[i] = std::lower_bound(runs[i].first, runs[i].second, *v) - runs[i].first;
+		need -= split[i];
+	}
+
+	for (std::size_t i = 0; i < k && need; i++)
+	{
+		const std::size_t equal = (std::upper_bound(runs[i].first, runs[i].second, *v) - runs[i].first) - split[i];
+		const std::size_t take = std::min(need, equal);
+
+		split[i] += take;
+		need -= take;
+	}
+
+	return split;
+}
+
+/*************************************************************************
+ * Sequential stable k-way merge of runs into out with a loser tree.
+ *************************************************************************/
+template <typename T>
+void multiwayMerge(const SortedRuns<T>& runs, T* out)
+{
+	const std::size_t k = runs.size();
+	std::vector<const T*> head(k);
+	LoserTree<T> tree(std::max<std::size_t>(k, 1));
+
+	for (std::size_t i = 0; i < k; i++)
+	{
+		head[i] = runs[i].first;
+
+		if (head[i] != runs[i].second)
+			tree.set(i, *head[i]);
+	}
+
+	tree.build();
+
+	while (k && !tree.empty())
+	{
+		const std::size_t i = tree.winner();
+
+		*out++ = *head[i]++;
+
+		if (head[i] != runs[i].second)
+			tree.set(i, *head[i]);
+		else
+			tree.close(i);
+
+		tree.replay(i);
+	}
+}
+
+/*************************************************************************
+ * Parallel stable k-way merge of runs into out: equal output parts, each
+ * located by multiwaySplit and merged by its own task.
+ *************************************************************************/
+template <typename T>
+void parallelMultiwayMerge(const SortedRuns<T>& runs, T* out, ThreadPool& pool)
+{
+	std::size_t n = 0;
+
+	for (const std::pair<const T*, const T*>& run : runs)
+		n += run.second - run.first;
+
+	const std::size_t parts = selectStripes(n, pool);
+
+	pool.parallelFor(parts, [&](std::size_t p, unsigned w) {
+		const std::size_t lo = n*p/parts, hi = n*(p + 1)/parts;
+		const std::vector<std::size_t> first = multiwaySplit(runs, lo), last = multiwaySplit(runs, hi);
+		SortedRuns<T> slice;
+
+		for (std::size_t i = 0; i < runs.size(); i++)
+			if (first[i] < last[i])
+				slice.emplace_back(runs[i].first + first[i], runs[i].first + last[i]);
+
+		multiwayMerge(slice, out + lo);
+		pool.addWork(w, hi - lo);
+	});
+}
+
+template <typename T>
+void parallelMultiwayMerge(const SortedRuns<T>& runs, T* out) { parallelMultiwayMerge(runs, out, sortPool()); }
+
+#endif
@@ -0,0 +1,368 @@
+/*************************************************************************
+* Title: SIMD Sort.
+* File: simd_sort.h
+* Date: 10/16/2026
+*
+* Vectorized quicksort for 32-bit keys with runtime CPU dispatch:
+*   AVX-512 (16 lanes, compress-store partition)
+*   AVX2 (8 lanes, permutation table partition)
+*   SSE4.2 (4 lanes, byte shuffle table partition)
+*   scalar std::sort otherwise
+*
+* Notes:
+*  (1) In the style of vqsort/x86-simd-sort: partitions of more than 16
+*      registers are split by an in-place vectorized partition around a
+*      median of three pivot; smaller ones are sorted by bitonic sorting
+*      networks held in registers (64 to 256 keys per block).
+*  (2) int32_t keys are sorted directly; uint32_t keys have their sign
+*      bit flipped before and after.  Other types use std::sort.
+*  (3) The kernel in simd_sort_core.h is compiled once per instruction set
+*      with "#pragma GCC target", so no special compiler flags are needed.
+*  (4) simdDispatch() may be lowered with limitSimdLevel() to benchmark
+*      the narrower instruction sets.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _SIMD_SORT_H_
+#define _SIMD_SORT_H_
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_SORT_X86 1
+#else
+#define SIMD_SORT_X86 0
+#endif
+
+// Instruction sets the SIMD sort can use, in increasing order.
+enum simdLevel { SIMD_NONE, SIMD_SSE4, SIMD_AVX2, SIMD_AVX512 };
+
+// Printable name of an instruction set level.
+inline const char* simdLevelName(simdLevel level)
+{
+	static const char* names[] = { "scalar", "sse4", "avx2", "avx512" };
+
+	return names[level];
+}
+
+// Highest instruction set supported by the CPU and operating system.
+inline simdLevel detectSimdLevel()
+{
+#if SIMD_SORT_X86 && defined(__GNUC__)
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f"))
+		return SIMD_AVX512;
+
+	if (__builtin_cpu_supports("avx2"))
+		return SIMD_AVX2;
+
+	if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+		return SIMD_SSE4;
+#elif SIMD_SORT_X86 && defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 1);
+	const bool sse42 = (info[2] & (1 << 20)) && (info[2] & (1 << 23));
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+	__cpuidex(info, 7, 0);
+
+	if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6)
+		return SIMD_AVX512;
+
+	if ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6)
+		return SIMD_AVX2;
+
+	if (sse42)
+		return SIMD_SSE4;
+#endif
+	return SIMD_NONE;
+}
+
+// Instruction set used by simdSort.
+inline simdLevel& simdDispatch()
+{
+	static simdLevel level = detectSimdLevel();
+
+	return level;
+}
+
+// Restricts simdSort to at most the given instruction set.
+inline void limitSimdLevel(simdLevel max)
+{
+	if (max < simdDispatch())
+		simdDispatch() = max;
+}
+
+#if SIMD_SORT_X86
+// Number of set bits.
+inline int popCount(unsigned x)
+{
+#if defined(_MSC_VER)
+	return static_cast<int>(__popcnt(x));
+#else
+	return __builtin_popcount(x);
+#endif
+}
+
+// For each lane mask, lane indices with the masked lanes first and the
+// others after, both in lane order.
+template <int L>
+struct CompressTable
+{
+	int32_t idx[1 << L][L];
+
+	constexpr CompressTable() : idx()
+	{
+		for (int m = 0; m < (1 << L); m++)
+		{
+			int k = 0;
+
+			for (int lane = 0; lane < L; lane++)
+				if (m & (1 << lane))
+					idx[m][k++] = lane;
+
+			for (int lane = 0; lane < L; lane++)
+				if (!(m & (1 << lane)))
+					idx[m][k++] = lane;
+		}
+	}
+};
+
+/*************************************************************************
+ * AVX-512 kernel.
+ *************************************************************************/
+#if defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,popcnt")
+#endif
+namespace simd_avx512
+{
+	struct Vec
+	{
+		typedef __m512i reg;
+		static constexpr int LANES = 16;
+
+		// Operations use the zero-masked forms with every lane enabled; the
+		// unmasked forms draw GCC 12 "used uninitialized" false positives.
+		static constexpr __mmask16 ALL = 0xFFFF;
+
+		static reg load(const int32_t* p) { return _mm512_loadu_si512(p); }
+		static void store(int32_t* p, reg v) { _mm512_storeu_si512(p, v); }
+		static reg set1(int32_t x) { return _mm512_set1_epi32(x); }
+		static reg min(reg a, reg b) { return _mm512_maskz_min_epi32(ALL, a, b); }
+		static reg max(reg a, reg b) { return _mm512_maskz_max_epi32(ALL, a, b); }
+
+		// Lanes of b where bits are set, otherwise lanes of a.
+		static reg blend(reg a, reg b, unsigned bits) { return _mm512_mask_blend_epi32(__mmask16(bits), a, b); }
+
+		// Swaps each lane with the lane D away (lane ^ D).
+		template <int D>
+		static reg permuteXor(reg v)
+		{
+			if constexpr (D == 1)
+				return _mm512_maskz_shuffle_epi32(ALL, v, _MM_PERM_CDAB);
+			else if constexpr (D == 2)
+				return _mm512_maskz_shuffle_epi32(ALL, v, _MM_PERM_BADC);
+			else if constexpr (D == 4)
+				return _mm512_maskz_shuffle_i32x4(ALL, v, v, _MM_SHUFFLE(2, 3, 0, 1));
+			else
+				return _mm512_maskz_shuffle_i32x4(ALL, v, v, _MM_SHUFFLE(1, 0, 3, 2));
+		}
+
+		static reg reverse(reg v)
+		{
+			return _mm512_maskz_permutexvar_epi32(ALL, _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), v);
+		}
+
+		// Bit i is set if lane i of v is less than lane i of p.
+		static unsigned lessThan(reg v, reg p) { return _mm512_cmplt_epi32_mask(v, p); }
+
+		// Stores the lt lanes at left and the others ending at right.
+		static void partitionStore(int32_t* left, int32_t* right, reg v, unsigned lt, int k)
+		{
+			_mm512_mask_compressstoreu_epi32(left, __mmask16(lt), v);
+			_mm512_mask_compressstoreu_epi32(right - (LANES - k), __mmask16(~lt), v);
+		}
+	};
+
+#include "simd_sort_core.h"
+}
+#if defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+/*************************************************************************
+ * AVX2 kernel.
+ *************************************************************************/
+#if defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+#endif
+namespace simd_avx2
+{
+	struct Vec
+	{
+		typedef __m256i reg;
+		static constexpr int LANES = 8;
+		static constexpr CompressTable<LANES> table{};
+
+		static reg load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+		static void store(int32_t* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+		static reg set1(int32_t x) { return _mm256_set1_epi32(x); }
+		static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+		static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+
+		// Lanes of b where bits are set, otherwise lanes of a.
+		static reg blend(reg a, reg b, unsigned bits)
+		{
+			const reg laneBit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+			const reg mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(int(bits)), laneBit), laneBit);
+
+			return _mm256_blendv_epi8(a, b, mask);
+		}
+
+		// Swaps each lane with the lane D away (lane ^ D).
+		template <int D>
+		static reg permuteXor(reg v)
+		{
+			if constexpr (D == 1)
+				return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+			else if constexpr (D == 2)
+				return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+			else
+				return _mm256_permute2x128_si256(v, v, 1);
+		}
+
+		static reg reverse(reg v) { return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+		// Bit i is set if lane i of v is less than lane i of p.
+		static unsigned lessThan(reg v, reg p) { return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(p, v)))); }
+
+		// Stores the lt lanes at left and the others ending at right.  Both
+		// stores write a whole register; the partition guarantees room.
+		static void partitionStore(int32_t* left, int32_t* right, reg v, unsigned lt, int)
+		{
+			const reg packed = _mm256_permutevar8x32_epi32(v, load(table.idx[lt]));
+
+			store(left, packed);
+			store(right - LANES, packed);
+		}
+	};
+
+#include "simd_sort_core.h"
+}
+#if defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+/*************************************************************************
+ * SSE4.2 kernel.
+ *************************************************************************/
+#if defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse4.2,popcnt")
+#endif
+namespace simd_sse4
+{
+	struct Vec
+	{
+		typedef __m128i reg;
+		static constexpr int LANES = 4;
+		static constexpr CompressTable<LANES> table{};
+
+		static reg load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		static void store(int32_t* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+		static reg set1(int32_t x) { return _mm_set1_epi32(x); }
+		static reg min(reg a, reg b) { return _mm_min_epi32(a, b); }
+		static reg max(reg a, reg b) { return _mm_max_epi32(a, b); }
+
+		// Lanes of b where bits are set, otherwise lanes of a.
+		static reg blend(reg a, reg b, unsigned bits)
+		{
+			const reg laneBit = _mm_setr_epi32(1, 2, 4, 8);
+			const reg mask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(int(bits)), laneBit), laneBit);
+
+			return _mm_blendv_epi8(a, b, mask);
+		}
+
+		// Swaps each lane with the lane D away (lane ^ D).
+		template <int D>
+		static reg permuteXor(reg v)
+		{
+			if constexpr (D == 1)
+				return _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+			else
+				return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+		}
+
+		static reg reverse(reg v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+		// Bit i is set if lane i of v is less than lane i of p.
+		static unsigned lessThan(reg v, reg p) { return unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, p)))); }
+
+		// Stores the lt lanes at left and the others ending at right.  Both
+		// stores write a whole register; the partition guarantees room.
+		static void partitionStore(int32_t* left, int32_t* right, reg v, unsigned lt, int)
+		{
+			// Expand lane indices to byte indices for pshufb.
+			const reg lanes = _mm_slli_epi32(load(table.idx[lt]), 2);
+			const reg bytes = _mm_add_epi8(_mm_shuffle_epi8(lanes, _mm_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12)),
+				_mm_setr_epi8(0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3));
+			const reg packed = _mm_shuffle_epi8(v, bytes);
+
+			store(left, packed);
+			store(right - LANES, packed);
+		}
+	};
+
+#include "simd_sort_core.h"
+}
+#if defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+// Sorts int32_t keys with the widest available kernel.
+inline void simdSortInt32(int32_t* a, std::size_t n)
+{
+	switch (SIMD_SORT_X86 ? simdDispatch() : SIMD_NONE)
+	{
+#if SIMD_SORT_X86
+		case SIMD_AVX512: simd_avx512::quicksort(a, n); break;
+		case SIMD_AVX2:   simd_avx2::quicksort(a, n); break;
+		case SIMD_SSE4:   simd_sse4::quicksort(a, n); break;
+#endif
+		default:          std::sort(a, a + n); break;
+	}
+}
+
+/*************************************************************************
+ * SIMD quicksort with sorting network leaves (32-bit keys).
+ *************************************************************************/
+template <typename T>
+void simdSort(T* begin, T* end)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if constexpr (std::is_same<T, int32_t>::value)
+		simdSortInt32(begin, n);
+	else if constexpr (std::is_same<T, uint32_t>::value)
+	{
+		// Flipping the sign bit maps unsigned order onto signed order.
+		int32_t* a = reinterpret_cast<int32_t*>(begin);
+
+		for (T* p = begin; p != end; ++p)
+			*p ^= 0x80000000u;
+
+		simdSortInt32(a, n);
+
+		for (T* p = begin; p != end; ++p)
+			*p ^= 0x80000000u;
+	}
+	else
+		std::sort(begin, end);
+}
+
+#endif
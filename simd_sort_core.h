@@ -0,0 +1,250 @@
+/*************************************************************************
+* Title: SIMD Sort Kernel.
+* File: simd_sort_core.h
+* Date: 10/16/2026
+*
+* Instruction set independent body of the SIMD quicksort on int32_t keys:
+*   in-register bitonic sort (sortRegister)
+*   bitonic merge of sorted registers (mergeRegisters)
+*   sorting network for small blocks (smallSort)
+*   in-place vectorized partition (partition)
+*   quicksort driver (quicksort)
+*
+* Notes:
+*  (1) Deliberately has no include guard.  simd_sort.h includes it once
+*      per instruction set, inside a namespace that defines Vec (the
+*      register type and operations) and, with GCC/Clang, inside a
+*      matching "#pragma GCC target" region.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+
+typedef Vec::reg reg;
+constexpr int LANES = Vec::LANES;           // Keys per register.
+constexpr int MAX_REGS = 16;                // Registers in a small block.
+constexpr std::size_t SMALL_SORT = LANES*MAX_REGS;
+
+// Lanes that keep the minimum in the bitonic stage comparing lanes D
+// apart, within ascending/descending blocks of size S.
+constexpr unsigned minLanes(int S, int D)
+{
+	unsigned bits = 0;
+
+	for (int lane = 0; lane < LANES; lane++)
+		if (((lane & D) == 0) == ((lane & S) == 0))
+			bits |= 1u << lane;
+
+	return bits;
+}
+
+// Bitonic stages of distance D, D/2, ..., 1 within blocks of size S.
+template <int S, int D>
+struct BitonicStages
+{
+	static reg apply(reg v)
+	{
+		const reg p = Vec::permuteXor<D>(v);
+
+		v = Vec::blend(Vec::max(v, p), Vec::min(v, p), minLanes(S, D));
+
+		return BitonicStages<S, D/2>::apply(v);
+	}
+};
+
+template <int S>
+struct BitonicStages<S, 0>
+{
+	static reg apply(reg v) { return v; }
+};
+
+// Bitonic sort of each block of S lanes (ascending/descending alternately).
+template <int S>
+struct BitonicSort
+{
+	static reg apply(reg v) { return BitonicStages<S, S/2>::apply(BitonicSort<S/2>::apply(v)); }
+};
+
+template <>
+struct BitonicSort<1>
+{
+	static reg apply(reg v) { return v; }
+};
+
+// Sorts the lanes of one register.
+inline reg sortRegister(reg v) { return BitonicSort<LANES>::apply(v); }
+
+// Sorts the lanes of a bitonic register.
+inline reg cleanRegister(reg v) { return BitonicStages<2*LANES, LANES/2>::apply(v); }
+
+// Merges r[0, w) and r[w, 2w), each sorted in register-major order.
+inline void mergeRegisters(reg* r, int w)
+{
+	// Reverse the second half, making the whole sequence bitonic.
+	for (int i = 0; i < w/2; i++)
+		std::swap(r[w + i], r[2*w - 1 - i]);
+
+	for (int i = w; i < 2*w; i++)
+		r[i] = Vec::reverse(r[i]);
+
+	// Compare-exchange registers at distance w, w/2, ..., 1.
+	for (int dist = w; dist > 0; dist /= 2)
+		for (int i = 0; i < 2*w; i++)
+			if ((i & dist) == 0)
+			{
+				const reg lo = Vec::min(r[i], r[i + dist]);
+				r[i + dist] = Vec::max(r[i], r[i + dist]);
+				r[i] = lo;
+			}
+
+	// Finish inside each register.
+	for (int i = 0; i < 2*w; i++)
+		r[i] = cleanRegister(r[i]);
+}
+
+// Sorting network for n <= SMALL_SORT keys, padded to a power of two
+// registers with the largest key.
+inline void smallSort(int32_t* a, std::size_t n)
+{
+	alignas(64) int32_t buf[SMALL_SORT];
+	reg r[MAX_REGS];
+	int regs = 1;
+
+	while (std::size_t(regs)*LANES < n)
+		regs *= 2;
+
+	std::copy(a, a + n, buf);
+	std::fill(buf + n, buf + regs*LANES, std::numeric_limits<int32_t>::max());
+
+	for (int i = 0; i < regs; i++)
+		r[i] = sortRegister(Vec::load(buf + i*LANES));
+
+	for (int w = 1; w < regs; w *= 2)
+		for (int g = 0; g < regs; g += 2*w)
+			mergeRegisters(r + g, w);
+
+	for (int i = 0; i < regs; i++)
+		Vec::store(buf + i*LANES, r[i]);
+
+	std::copy(buf, buf + n, a);
+}
+
+// Partitions n >= 2*LANES keys in place around pivot and returns the
+// number of keys less than pivot, which are moved to the front.
+// The first and last registers are set aside to open a gap, then each
+// register is read from whichever side has less free space (so both
+// sides always have a register of room) and its lanes are stored to
+// the left and right write positions.
+inline std::size_t partition(int32_t* a, std::size_t n, int32_t pivot)
+{
+	const reg p = Vec::set1(pivot);
+	const reg first = Vec::load(a), last = Vec::load(a + n - LANES);
+	int32_t* left = a, *right = a + n;
+	int32_t* readLeft = a + LANES, *readRight = a + n - LANES;
+
+	while (readRight - readLeft >= LANES)
+	{
+		reg v;
+
+		if ((readLeft - left) <= (right - readRight))
+		{
+			v = Vec::load(readLeft);
+			readLeft += LANES;
+		}
+		else
+		{
+			readRight -= LANES;
+			v = Vec::load(readRight);
+		}
+
+		const unsigned lt = Vec::lessThan(v, p);
+		const int k = popCount(lt);
+
+		Vec::partitionStore(left, right, v, lt, k);
+		left += k;
+		right -= LANES - k;
+	}
+
+	// The gap now holds exactly the unread keys plus the two saved registers.
+	alignas(64) int32_t rest[3*LANES];
+	const std::size_t remaining = readRight - readLeft;
+
+	std::copy(readLeft, readRight, rest);
+	Vec::store(rest + remaining, first);
+	Vec::store(rest + remaining + LANES, last);
+
+	for (std::size_t i = 0; i < remaining + 2*LANES; i++)
+		if (rest[i] < pivot)
+			*left++ = rest[i];
+		else
+			*--right = rest[i];
+
+	return left - a;
+}
+
+// Median of three keys.
+inline int32_t median3(int32_t x, int32_t y, int32_t z)
+{
+	return std::max(std::min(x, y), std::min(std::max(x, y), z));
+}
+
+// Quicksort with vectorized partitioning and sorting network leaves.  The
+// smaller side is sorted first from an explicit stack, and ranges still
+// unsorted after 2*log2(n) partitions are finished by std::sort.
+inline void quicksort(int32_t* a, std::size_t n)
+{
+	struct Range { int32_t* a; std::size_t n; int depth; };
+	Range stack[64];
+	int top = 0;
+	int depth = 0;
+
+	for (std::size_t m = n; m > 1; m >>= 1)
+		depth += 2;
+
+	stack[top++] = Range{ a, n, depth };
+
+	while (top)
+	{
+		Range r = stack[--top];
+
+		while (r.n > SMALL_SORT)
+		{
+			if (r.depth-- == 0)
+			{
+				std::sort(r.a, r.a + r.n);
+				r.n = 0;
+				break;
+			}
+
+			const int32_t pivot = median3(r.a[r.n/4], r.a[r.n/2], r.a[3*r.n/4]);
+			std::size_t k = partition(r.a, r.n, pivot);
+
+			if (k == 0)
+			{
+				// Pivot is the minimum: split off the keys equal to it.
+				if (pivot == std::numeric_limits<int32_t>::max())
+				{
+					r.n = 0;
+					break;
+				}
+
+				k = partition(r.a, r.n, pivot + 1);
+				r.a += k;
+				r.n -= k;
+				continue;
+			}
+
+			// Defer the larger side, keep partitioning the smaller one.
+			Range lo{ r.a, k, r.depth }, hi{ r.a + k, r.n - k, r.depth };
+
+			if (lo.n < hi.n)
+				std::swap(lo, hi);
+
+			stack[top++] = lo;
+			r = hi;
+		}
+
+		if (r.n > 1)
+			smallSort(r.a, r.n);
+	}
+}
@@ -45,6 +45,7 @@
 *  (5) Compiled for x86 with optimization set for speed: /O2
 *  (6) For most accurate timing results, use Release build.
 *  (7) Option to redirect output to file by defining: REDIRECT_TO_FILE.
+*      Any command line option runs a sweep writing CSV/JSON (see --help).
 *  (8) Compiled/tested with MS Visual Studio 2017 Community (v141), and
 *      Windows SDK version 10.0.17134.0
 *  (9) Compiled/tested with Eclipse Oxygen.3a Release (4.7.3a), using
@@ -53,6 +54,30 @@
 * Submitted in partial fulfillment of the requirements of PCC CIS-269.
 *************************************************************************
 * Change Log:
+*   10/16/2026: Verify sorts of tiny float arrays with NaN and signed zeros.
+*   10/16/2026: Verify stability of the stable record sorts; add stable sorts.
+*   10/16/2026: Benchmark string sorts; add --strings option.
+*   10/16/2026: Benchmark segmented sorts; add --segments option.
+*   10/16/2026: Benchmark many tiny sorts; add --tiny option.
+*   10/16/2026: Benchmark comparator and projection front-ends.
+*   10/16/2026: Benchmark write-combining radix sort.
+*   10/16/2026: Add test data orders; add --seed, --inversions options.
+*   10/16/2026: Benchmark incremental sorted array; add --lsm option.
+*   10/16/2026: Benchmark parallel top-k and merge; add --topk, --merge options.
+*   10/16/2026: Benchmark NUMA-aware sort; add --numa option.
+*   10/16/2026: Benchmark parallel sample sort; add --threads, --pin options.
+*   10/16/2026: Benchmark automatic sort selection; add --calibrate option.
+*   10/16/2026: Benchmark parallel counting sort.
+*   10/16/2026: Add memory-mapped file sort mode.
+*   10/16/2026: Add external (out-of-core) sort mode.
+*   10/16/2026: Benchmark powersort on ordered input.
+*   10/16/2026: Benchmark SIMD quicksort; add --simd-level option.
+*   10/16/2026: Count heap allocations; benchmark scratch arena sorts.
+*   10/16/2026: Add record (key + payload) sort sweep.
+*   10/16/2026: Add float and double element types to sweep.
+*   10/16/2026: Benchmark portable parallel radix sort.
+*   10/16/2026: Add hardware performance counter option.
+*   10/16/2026: Add command line sweep with CSV/JSON results.
 *   11/29/2018: Add C++17 parallel algorithm sort. JME
 *   11/16/2018: Initial release. JME
 *************************************************************************/
@@ -60,6 +85,7 @@
 
 #include <cstdio>     // freopen
 #include <cstdlib>    // exit
+#include <cstdint>    // fixed width element types
 #include <iostream>   // cout
 #include <algorithm>  // sort, make_heap, sort_heap, swap, distance, minmax
 #include <iostream>   // cout
@@ -68,17 +94,70 @@
 #include <vector>     // used by counting sort
 #include <random>     // mercenne twister prng
 #include <exception>  // runtime exception
+#include <memory>     // unique_ptr
+#include <numeric>    // accumulate
+#include <cmath>      // sqrt, ceil, log
+#include <string>     // sweep option and result names
+#include <cctype>     // toupper
+#include <sstream>    // option list parsing
+#include <fstream>    // results file
+#include <thread>     // parallel radix sort
+#include <array>      // parallel radix histograms
+#include <type_traits> // radix key transforms
+#include <atomic>     // allocation count
+#include <new>        // replacement operator new
+#include <limits>     // SIMD sort padding key
+#include <future>     // asynchronous block I/O
+#include <functional> // bind2nd, invoke, thread pool tasks
+#include <deque>      // thread pool task queues
+#include <mutex>      // thread pool locks
+#include <condition_variable> // thread pool sleep and wake
 #if (_MSC_VER && __cpp_lib_parallel_algorithm < 201603)
-#include <functional> // bind2nd
 #include <ppl.h>      // concurrency 
 #include <concrtrm.h> // concurrency
 #endif
 #if (__cpp_lib_parallel_algorithm >= 201603)
 #include <execution>  // par_unseq
 #endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h> // SSE4.2, AVX2, AVX-512 intrinsics
+#if defined(_MSC_VER)
+#include <intrin.h>    // __cpuidex, __popcnt
+#endif
+#endif
+#if defined(__linux__)
+#include <unistd.h>            // syscall, read, close
+#include <sys/mman.h>          // mmap, madvise
+#include <sys/stat.h>          // fstat
+#include <fcntl.h>             // open
+#include <sched.h>             // sched_getaffinity
+#include <pthread.h>           // pthread_setaffinity_np
+#include <sys/ioctl.h>         // ioctl
+#include <sys/syscall.h>       // __NR_perf_event_open
+#include <linux/perf_event.h>  // perf_event_attr
+#endif
 
 //#include "pch.h"
-#include "sort_funcs.h" // sort and benchmark functions
+#include "perf_counters.h" // hardware performance counters
+#include "bench_stats.h"   // benchmark statistics
+#include "scratch_arena.h" // reusable scratch memory
+#include "sort_funcs.h"    // sort and benchmark functions
+#include "tiny_sort.h"     // sorting networks for tiny arrays
+#include "simd_sort.h"     // vectorized quicksort
+#include "radix_wc.h"      // write-combining radix sort
+#include "sort_by.h"       // comparator and projection front-ends
+#include "thread_pool.h"   // work-stealing thread pool
+#include "sample_sort.h"   // parallel sample sort
+#include "numa_sort.h"     // NUMA-aware parallel sort
+#include "auto_sort.h"     // automatic algorithm selection
+#include "external_sort.h" // out-of-core sort
+#include "select_merge.h"  // parallel selection and multiway merge
+#include "lsm_sort.h"      // incremental sorted array
+#include "segmented_sort.h" // segmented sort
+#include "string_sort.h"   // string sorts
+#include "stable_sort.h"   // stable sorts
+#include "mapped_file.h"   // memory-mapped file sort
+#include "results.h"       // CSV/JSON results output
 
 // Uncomment to redirect output to file.
 //#define REDIRECT_TO_FILE
@@ -87,8 +166,1247 @@
 constexpr int MIN_ELEMENTS{ 1000 };
 constexpr int MAX_ELEMENTS{ 10000000 };
 
+// Kept out of line, so GCC does not pair an inlined malloc() or free()
+// with the other operator and flag them as mismatched.
+#if defined(__GNUC__)
+#define NOINLINE __attribute__((noinline))
+#else
+#define NOINLINE
+#endif
+
+// Replacement global allocation functions count heap allocations.
+NOINLINE void* operator new(std::size_t size)
+{
+	allocationCount++;
+
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Benchmark entry point of one Sort policy.
+typedef BenchStats (*BenchFn)(int, order, const BenchConfig&);
+
+template <typename T, void(*S)(T*, T*)>
+BenchStats bench(int n, order type, const BenchConfig& cfg) { return Sort<T, S>().benchmark(n, type, cfg); }
+
+// Front-end of sort_by.h sorting a std::vector<T> by Compare.
+template <typename T, typename Compare>
+using SortByFn = void(*)(typename std::vector<T>::iterator, typename std::vector<T>::iterator, Compare, Identity);
+
+// Benchmarks a sort_by.h front-end through std::vector iterators, for 
+// comparison with the T* kernel it wraps.
+template <typename T, typename Compare, SortByFn<T, Compare> S>
+BenchStats benchBy(int n, order type, const BenchConfig& cfg)
+{
+	std::unique_ptr<T[]> source(constructTestArray<T>(n, type));
+	std::vector<T> work(n);
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { std::copy(source.get(), source.get() + n, work.begin()); },
+			[&] { S(work.begin(), work.end(), Compare(), Identity()); },
+			[&] {
+				if (!std::is_sorted(work.begin(), work.end(), Compare()))
+					throw std::runtime_error("sort failed");
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, n);
+
+	return stats;
+}
+
+// Memory-mapped file benchmark entry point of one Sort policy.
+typedef BenchStats (*FileBenchFn)(const FileConfig&, const BenchConfig&);
+
+// Named sort policy, the largest n a sweep runs it at by default, and 
+// its file benchmark (if it can sort files).
+struct Algorithm
+{
+	const char* name;
+	BenchFn fn;
+	int maxElements;
+	FileBenchFn file;
+};
+
+// Sort policies available to the sweep for element type T.
+// Counting sort requires integral keys.
+template <typename T>
+std::vector<Algorithm> algorithms()
+{
+	std::vector<Algorithm> v = {
+		{ "stl",           bench<T, stlSort<T>>,              MAX_ELEMENTS, benchFile<T, stlSort<T>> },
+		{ "heap",          bench<T, heapSort<T>>,             MAX_ELEMENTS, benchFile<T, heapSort<T>> },
+		{ "insertion",     bench<T, insertionSort<T>>,        100000,       benchFile<T, insertionSort<T>> },
+		{ "comb",          bench<T, combSort<T>>,             MAX_ELEMENTS, benchFile<T, combSort<T>> },
+		{ "radix",         bench<T, radixSort<T>>,            MAX_ELEMENTS, benchFile<T, radixSort<T>> },
+		{ "radix_arena",   bench<T, radixSortArena<T>>,       MAX_ELEMENTS, benchFile<T, radixSortArena<T>> },
+		{ "radix_wc",      bench<T, radixSortWC<T>>,          MAX_ELEMENTS, benchFile<T, radixSortWC<T>> },
+		{ "radix_by",      benchBy<T, std::less<>, radixSortBy>,      MAX_ELEMENTS, nullptr },
+		{ "radix_desc",    benchBy<T, std::greater<>, radixSortBy>,   MAX_ELEMENTS, nullptr },
+		{ "pradix",        bench<T, pRadix<T>>,               MAX_ELEMENTS, benchFile<T, pRadix<T>> },
+#if (__cpp_lib_parallel_algorithm >= 201603 || _MSC_VER)
+		{ "psort",         bench<T, pSort<T>>,                MAX_ELEMENTS, benchFile<T, pSort<T>> },
+#endif
+		{ "quick",         bench<T, quickSort<T>>,            MAX_ELEMENTS, benchFile<T, quickSort<T>> },
+		{ "quick_by",      benchBy<T, std::less<>, quickSortBy>,      MAX_ELEMENTS, nullptr },
+		{ "quick_desc",    benchBy<T, std::greater<>, quickSortBy>,   MAX_ELEMENTS, nullptr },
+		{ "power",         bench<T, powerSort<T>>,            MAX_ELEMENTS, benchFile<T, powerSort<T>> },
+		{ "power_by",      benchBy<T, std::less<>, powerSortBy>,      MAX_ELEMENTS, nullptr },
+		{ "stl_stable",    bench<T, stlStableSort<T>>,        MAX_ELEMENTS, benchFile<T, stlStableSort<T>> },
+#if (__cpp_lib_parallel_algorithm >= 201603)
+		{ "pstl_stable",   bench<T, pStableSort<T>>,          MAX_ELEMENTS, benchFile<T, pStableSort<T>> },
+#endif
+		{ "pstable",       bench<T, parallelStableSort<T>>,   MAX_ELEMENTS, benchFile<T, parallelStableSort<T>> },
+		{ "pradix_stable", bench<T, parallelRadixSort<T>>,    MAX_ELEMENTS, benchFile<T, parallelRadixSort<T>> },
+		{ "simd",          bench<T, simdSort<T>>,             MAX_ELEMENTS, benchFile<T, simdSort<T>> },
+		{ "sample",        bench<T, sampleSort<T>>,           MAX_ELEMENTS, benchFile<T, sampleSort<T>> },
+		{ "numa",          bench<T, numaSort<T>>,             MAX_ELEMENTS, benchFile<T, numaSort<T>> },
+		{ "auto",          bench<T, autoSort<T>>,             MAX_ELEMENTS, benchFile<T, autoSort<T>> },
+	};
+
+	if constexpr (std::is_integral<T>::value)
+	{
+		v.insert(v.begin() + 4, Algorithm{ "counting", bench<T, countingSort<T>>, MAX_ELEMENTS, benchFile<T, countingSort<T>> });
+		v.insert(v.begin() + 5, Algorithm{ "counting_arena", bench<T, countingSortArena<T>>, MAX_ELEMENTS, benchFile<T, countingSortArena<T>> });
+		v.insert(v.begin() + 6, Algorithm{ "pcounting", bench<T, pCounting<T>>, MAX_ELEMENTS, benchFile<T, pCounting<T>> });
+	}
+
+	return v;
+}
+
+// Stability declared by the policies (stable_sort.h).
+static_assert(Sort<int, radixSort>::stable && Sort<int, countingSort>::stable && Sort<int, pRadix>::stable, "radix and counting sorts are stable");
+static_assert(!Sort<int, stlSort>::stable && !Sort<int, quickSort>::stable && !Sort<int, combSort>::stable
+	&& !Sort<int, heapSort>::stable && !Sort<int, pSort>::stable, "comparison sorts other than merge sorts are not stable");
+static_assert(Sort<int, parallelStableSort>::stable && Sort<int, parallelRadixSort>::stable, "parallel stable sorts are stable");
+
+// Sweep settings parsed from the command line.
+struct SweepOptions
+{
+	std::vector<std::string> algorithms;               // Empty selects all.
+	std::vector<int> sizes;                            // Empty selects MIN..MAX decades.
+	std::vector<std::string> types{ "int32" };         // Element types.
+	std::vector<order> orders{ order::RANDOM };        // Input distributions.
+	std::vector<int> payloads;                         // Record payload sizes; selects record sweep.
+	std::vector<int> topK;                             // Top-k counts; selects selection sweep.
+	std::vector<int> shards;                           // Sorted run counts; selects merge sweep.
+	std::vector<int> batches;                          // Append batch sizes; selects append sweep.
+	std::vector<int> tiny;                             // Tiny array sizes; selects tiny sorts sweep.
+	std::vector<SegmentShape> segments;                // Segment layouts; selects segmented sort sweep.
+	std::size_t segmentMean = 16;                      // Mean segment length.
+	std::vector<StringShape> strings;                  // String shapes; selects string sweep.
+	std::string format{ "csv" };                       // csv or json.
+	std::string out;                                   // Empty writes to stdout.
+	bool noLimits = false;                             // Ignore per-algorithm size caps.
+	bool calibrate = false;                            // Calibrate auto sort before the sweep.
+	int threads = 0;                                   // Sort pool threads; 0 is one per CPU.
+	bool pin = false;                                  // Pin sort pool threads to CPUs.
+	std::vector<int> externalMB;                       // File sizes (MB); selects external sort.
+	ExternalConfig external;                           // External sort settings.
+	FileConfig file;                                   // Input file; selects memory-mapped file sort.
+	BenchConfig cfg;                                   // Measurement settings.
+};
+
+// Splits a comma separated option value.
+std::vector<std::string> splitList(const std::string& s)
+{
+	std::vector<std::string> v;
+	std::stringstream ss(s);
+
+	for (std::string item; std::getline(ss, item, ',');)
+		if (!item.empty())
+			v.push_back(item);
+
+	return v;
+}
+
+// Runs the selected algorithms over every order and size, appending a 
+// row per cell.
+void sweepAlgorithms(const std::vector<Algorithm>& algos, const std::string& typeName, std::size_t elemSize,
+	const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	for (const Algorithm& a : algos)
+	{
+		if (!opt.algorithms.empty() && std::find(opt.algorithms.begin(), opt.algorithms.end(), a.name) == opt.algorithms.end())
+			continue;
+
+		for (order o : opt.orders)
+			for (int n : opt.sizes)
+			{
+				if (n > a.maxElements && !opt.noLimits)
+				{
+					std::cerr << "skipping " << a.name << " n = " << n << " (use --no-limits)" << std::endl;
+					continue;
+				}
+
+				std::cerr << a.name << ' ' << typeName << ' ' << orderName(o) << " n = " << n << std::endl;
+
+				ResultRow r;
+				r.algorithm = a.name;
+				r.type = typeName;
+				r.order = orderName(o);
+				r.n = n;
+				r.elemSize = elemSize;
+				sortPool().resetStats();
+				numaStats() = NumaStats();
+				r.stats = a.fn(n, o, opt.cfg);
+				r.imbalance = loadImbalance(sortPool().stats());
+				rows.push_back(r);
+
+				// Per-thread load of sorts that ran on the pool, and the
+				// bandwidth of sorts that ran on several NUMA nodes.
+				if (r.imbalance >= 0.0)
+					reportLoadBalance(std::cerr, sortPool().stats());
+				reportNumaStats(std::cerr, numaStats());
+			}
+	}
+}
+
+// External sort of a file using one in-memory run sort kernel.
+typedef ExternalStats (*ExternalFn)(const std::string&, const std::string&, const ExternalConfig&);
+
+struct ExternalAlgorithm
+{
+	const char* name;
+	ExternalFn fn;
+};
+
+// Run sort kernels available to the external sort for element type T.
+template <typename T>
+std::vector<ExternalAlgorithm> externalAlgorithms()
+{
+	return {
+		{ "radix", externalSort<T, radixSort<T>> },
+#if (__cpp_lib_parallel_algorithm >= 201603 || _MSC_VER)
+		{ "psort", externalSort<T, pSort<T>> },
+#endif
+		{ "stl",   externalSort<T, stlSort<T>> },
+	};
+}
+
+// Sorts generated files of each size and order with the external sort,
+// verifying each output and appending a single-trial row per cell.
+template <typename T>
+void sweepExternal(const char* typeName, const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	const std::vector<std::string> selected = opt.algorithms.empty() ? std::vector<std::string>{ "radix" } : opt.algorithms;
+
+	for (const std::string& name : selected)
+	{
+		const std::vector<ExternalAlgorithm> all = externalAlgorithms<T>();
+		const auto a = std::find_if(all.begin(), all.end(), [&](const ExternalAlgorithm& x) { return name == x.name; });
+
+		if (a == all.end())
+		{
+			std::cerr << "skipping " << name << " (not available for external sort)" << std::endl;
+			continue;
+		}
+
+		for (order o : opt.orders)
+			for (int mb : opt.externalMB)
+			{
+				const std::size_t n = (std::size_t(mb) << 20)/sizeof(T);
+				TempFiles files;
+				files.paths = { opt.external.tempDir + "/sort_input.bin", opt.external.tempDir + "/sort_output.bin" };
+
+				std::cerr << "external_" << name << ' ' << typeName << ' ' << orderName(o) << ' ' << mb << " MB, "
+					<< (opt.external.memoryBytes >> 20) << " MB memory" << std::endl;
+
+				writeTestFile<T>(files.paths[0], n, o);
+				const ExternalStats es = a->fn(files.paths[0], files.paths[1], opt.external);
+				verifySortedFile<T>(files.paths[1], n);
+
+				std::cerr << "runs: " << es.runs << ", merge passes: " << es.passes << ", run phase: " << es.runSeconds
+					<< "s, merge phase: " << es.mergeSeconds << "s, " << es.gbPerSec() << " GB/s" << std::endl;
+
+				ResultRow r;
+				r.algorithm = std::string("external_") + name;
+				r.type = typeName;
+				r.order = orderName(o);
+				r.n = static_cast<long long>(n);
+				r.elemSize = sizeof(T);
+				r.stats.trials = 1;
+				r.stats.min = r.stats.median = r.stats.p95 = r.stats.mean = es.seconds()*1000.0;
+				rows.push_back(r);
+			}
+	}
+}
+
+// Sorts the keys of the input file through memory mappings with each 
+// selected algorithm, appending a row per algorithm.
+template <typename T>
+void sweepFile(const char* typeName, const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	std::ifstream f(opt.file.input, std::ios::binary | std::ios::ate);
+
+	if (!f)
+		throw std::runtime_error("cannot open " + opt.file.input);
+
+	const long long n = static_cast<long long>(f.tellg())/static_cast<long long>(sizeof(T));
+
+	for (const Algorithm& a : algorithms<T>())
+	{
+		if (!opt.algorithms.empty() && std::find(opt.algorithms.begin(), opt.algorithms.end(), a.name) == opt.algorithms.end())
+			continue;
+
+		if (n > a.maxElements && !opt.noLimits)
+		{
+			std::cerr << "skipping " << a.name << " n = " << n << " (use --no-limits)" << std::endl;
+			continue;
+		}
+
+		std::cerr << a.name << ' ' << typeName << ' ' << opt.file.input << " n = " << n << std::endl;
+
+		ResultRow r;
+		r.algorithm = a.name;
+		r.type = typeName;
+		r.order = "file";
+		r.n = n;
+		r.elemSize = sizeof(T);
+		r.stats = a.file(opt.file, opt.cfg);
+		rows.push_back(r);
+	}
+}
+
+// Rank count of the selection benchmarks, run count of the merge
+// benchmarks, batch size of the append benchmarks and array size of the
+// tiny sorts benchmarks, set by the sweep before each pass.
+std::size_t selectCount = 1;
+std::size_t mergeWays = 2;
+std::size_t appendBatch = LSM_BATCH;
+std::size_t tinySize = 16;
+
+// Baselines: STL top-k and selection.
+template <typename T>
+void stlPartialSort(T* begin, T* middle, T* end) { std::partial_sort(begin, middle, end); }
+
+template <typename T>
+void stlNthElement(T* begin, T* nth, T* end) { std::nth_element(begin, nth, end); }
+
+// Benchmarks putting the smallest selectCount keys first: in sorted order
+// (top-k), or only the largest of them in its sorted place (NTH).
+template <typename T, void(*S)(T*, T*, T*), bool NTH>
+BenchStats benchSelect(int n, order type, const BenchConfig& cfg)
+{
+	const std::size_t k = std::min<std::size_t>(std::max<std::size_t>(selectCount, 1), n);
+	std::unique_ptr<T[]> source(constructTestArray<T>(n, type)), work(new T[n]);
+	std::vector<T> sorted(source.get(), source.get() + n);
+
+	std::sort(sorted.begin(), sorted.end());
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { std::copy(source.get(), source.get() + n, work.get()); },
+			[&] { S(work.get(), work.get() + (NTH ? k - 1 : k), work.get() + n); },
+			[&] {
+				const T& kth = sorted[k - 1];
+				const bool front = NTH ? (work[k - 1] == kth && std::none_of(work.get(), work.get() + k, [&](const T& x) { return kth < x; }))
+					: std::equal(work.get(), work.get() + k, sorted.begin());
+
+				if (!front || std::any_of(work.get() + k, work.get() + n, [&](const T& x) { return x < kth; }))
+					throw std::runtime_error("selection failed");
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, n);
+
+	return stats;
+}
+
+// Baselines: sort the concatenated runs, or merge them pairwise in place.
+template <typename T>
+void stlSortRuns(const SortedRuns<T>& runs, T* out)
+{
+	T* end = out;
+
+	for (const std::pair<const T*, const T*>& run : runs)
+		end = std::copy(run.first, run.second, end);
+
+	std::sort(out, end);
+}
+
+template <typename T>
+void stlMergeRuns(const SortedRuns<T>& runs, T* out)
+{
+	std::vector<T*> bound{ out };
+
+	for (const std::pair<const T*, const T*>& run : runs)
+		bound.push_back(std::copy(run.first, run.second, bound.back()));
+
+	const std::size_t k = runs.size();
+
+	for (std::size_t width = 1; width < k; width *= 2)
+		for (std::size_t i = 0; i + width < k; i += 2*width)
+			std::inplace_merge(bound[i], bound[i + width], bound[std::min(i + 2*width, k)]);
+}
+
+// Benchmarks merging mergeWays sorted runs of the n keys.
+template <typename T, void(*M)(const SortedRuns<T>&, T*)>
+BenchStats benchMerge(int n, order type, const BenchConfig& cfg)
+{
+	const std::size_t k = std::min<std::size_t>(std::max<std::size_t>(mergeWays, 1), n);
+	std::unique_ptr<T[]> source(constructTestArray<T>(n, type)), work(new T[n]);
+	SortedRuns<T> runs;
+
+	for (std::size_t i = 0; i < k; i++)
+	{
+		T* first = source.get() + n*i/k, * last = source.get() + n*(i + 1)/k;
+
+		std::sort(first, last);
+		runs.emplace_back(first, last);
+	}
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { },
+			[&] { M(runs, work.get()); },
+			[&] {
+				if (!std::is_sorted(work.get(), work.get() + n))
+					throw std::runtime_error("merge failed");
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, n);
+
+	return stats;
+}
+
+// Baselines of the append benchmarks: re-sort the whole array after each
+// batch, or sort the batch and merge it into the array in place.
+template <typename T, bool MERGE>
+class SortedAppend
+{
+public:
+	explicit SortedAppend(std::size_t) { }
+
+	void insert(const T* begin, const T* end)
+	{
+		const std::size_t old = keys.size();
+
+		keys.insert(keys.end(), begin, end);
+
+		if (MERGE)
+		{
+			std::sort(keys.begin() + old, keys.end());
+			std::inplace_merge(keys.begin(), keys.begin() + old, keys.end());
+		}
+		else
+			stlSort(keys.data(), keys.data() + keys.size());
+	}
+
+	void sorted(std::vector<T>& out) const { out = keys; }
+
+private:
+	std::vector<T> keys;
+};
+
+// Benchmarks appending n keys in batches of appendBatch to a sorted 
+// container C, reporting the merge work of log-structured arrays.
+template <typename T, typename C>
+BenchStats benchAppend(int n, order type, const BenchConfig& cfg)
+{
+	const std::size_t batch = std::max<std::size_t>(appendBatch, 1);
+	std::unique_ptr<T[]> source(constructTestArray<T>(n, type));
+	std::unique_ptr<C> c;
+	std::vector<T> expect(source.get(), source.get() + n), result;
+
+	std::sort(expect.begin(), expect.end());
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { c.reset(new C(batch)); },
+			[&] {
+				for (std::size_t i = 0; i < std::size_t(n); i += batch)
+					c->insert(source.get() + i, source.get() + std::min<std::size_t>(i + batch, n));
+			},
+			[&] {
+				c->sorted(result);
+
+				if (result != expect)
+					throw std::runtime_error("sorted append failed");
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, n);
+
+	if constexpr (std::is_same<C, LsmArray<T>>::value)
+		reportLsmStats(std::cerr, c->stats(), c->levelCount());
+
+	return stats;
+}
+
+// Benchmarks sorting the n keys as consecutive arrays of tinySize keys 
+// (the last may be shorter): many small, independent sorts.
+template <typename T, void(*S)(T*, T*)>
+BenchStats benchTiny(int n, order type, const BenchConfig& cfg)
+{
+	const std::size_t k = std::max<std::size_t>(tinySize, 1);
+	std::unique_ptr<T[]> source(constructTestArray<T>(n, type)), work(new T[n]);
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { std::copy(source.get(), source.get() + n, work.get()); },
+			[&] {
+				for (std::size_t i = 0; i < std::size_t(n); i += k)
+					S(work.get() + i, work.get() + std::min<std::size_t>(i + k, n));
+			},
+			[&] {
+				for (std::size_t i = 0; i < std::size_t(n); i += k)
+					if (!std::is_sorted(work.get() + i, work.get() + std::min<std::size_t>(i + k, n)))
+						throw std::runtime_error("tiny sort failed");
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, n);
+
+	return stats;
+}
+
+// Top-k and selection strategies for element type T.
+template <typename T>
+std::vector<Algorithm> selectAlgorithms()
+{
+	return {
+		{ "stl_partial_sort", benchSelect<T, stlPartialSort<T>, false>,      MAX_ELEMENTS, nullptr },
+		{ "stl_nth_element",  benchSelect<T, stlNthElement<T>, true>,        MAX_ELEMENTS, nullptr },
+		{ "ptopk",            benchSelect<T, parallelPartialSort<T>, false>, MAX_ELEMENTS, nullptr },
+		{ "pselect",          benchSelect<T, parallelNthElement<T>, true>,   MAX_ELEMENTS, nullptr },
+	};
+}
+
+// Multiway merge strategies for element type T.
+template <typename T>
+std::vector<Algorithm> mergeAlgorithms()
+{
+	return {
+		{ "stl_sort",    benchMerge<T, stlSortRuns<T>>,           MAX_ELEMENTS, nullptr },
+		{ "stl_merge",   benchMerge<T, stlMergeRuns<T>>,          MAX_ELEMENTS, nullptr },
+		{ "loser_merge", benchMerge<T, multiwayMerge<T>>,         MAX_ELEMENTS, nullptr },
+		{ "pmerge",      benchMerge<T, parallelMultiwayMerge<T>>, MAX_ELEMENTS, nullptr },
+	};
+}
+
+// Sorted append strategies for element type T.
+template <typename T>
+std::vector<Algorithm> appendAlgorithms()
+{
+	return {
+		{ "resort", benchAppend<T, SortedAppend<T, false>>, 100000,       nullptr },
+		{ "merge",  benchAppend<T, SortedAppend<T, true>>,  1000000,      nullptr },
+		{ "lsm",    benchAppend<T, LsmArray<T>>,            MAX_ELEMENTS, nullptr },
+	};
+}
+
+// Tiny array sort strategies for element type T.  Counting sort 
+// requires integral keys.
+template <typename T>
+std::vector<Algorithm> tinyAlgorithms()
+{
+	std::vector<Algorithm> v = {
+		{ "stl",       benchTiny<T, stlSort<T>>,       MAX_ELEMENTS, nullptr },
+		{ "insertion", benchTiny<T, insertionSort<T>>, MAX_ELEMENTS, nullptr },
+		{ "quick",     benchTiny<T, quickSort<T>>,     MAX_ELEMENTS, nullptr },
+		{ "radix",     benchTiny<T, radixSort<T>>,     MAX_ELEMENTS, nullptr },
+		{ "network",   benchTiny<T, networkSort<T>>,   MAX_ELEMENTS, nullptr },
+	};
+
+	if constexpr (std::is_integral<T>::value)
+		v.insert(v.begin() + 4, Algorithm{ "counting", benchTiny<T, countingSort<T>>, MAX_ELEMENTS, nullptr });
+
+	return v;
+}
+
+// Runs the selection, merge, append (or tiny sort) algorithms once per 
+// top-k, run, batch (or array size) count, naming each row's algorithm 
+// with the count.
+template <typename T>
+void sweepCounts(const char* typeName, const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	const bool select = !opt.topK.empty(), merge = !select && !opt.shards.empty();
+	const bool append = !select && !merge && !opt.batches.empty(), tiny = !select && !merge && !append;
+	const std::vector<Algorithm> algos = select ? selectAlgorithms<T>() : merge ? mergeAlgorithms<T>() 
+		: append ? appendAlgorithms<T>() : tinyAlgorithms<T>();
+	const std::string label = select ? "(k=" : merge ? "(runs=" : append ? "(batch=" : "(size=";
+
+	for (int c : select ? opt.topK : merge ? opt.shards : append ? opt.batches : opt.tiny)
+	{
+		const std::size_t first = rows.size();
+
+		(select ? selectCount : merge ? mergeWays : append ? appendBatch : tinySize) = std::size_t(c);
+		sweepAlgorithms(algos, typeName, sizeof(T), opt, rows);
+
+		for (std::size_t i = first; i < rows.size(); i++)
+		{
+			rows[i].algorithm += label + std::to_string(c) + ")";
+			rows[i].sortSize = tiny ? c : 0;
+		}
+	}
+}
+
+// Segment layout of the segmented sort benchmarks, set by the sweep 
+// before each pass.
+SegmentShape segmentShape = SEGMENT_UNIFORM;
+std::size_t segmentMean = 16;
+
+// Baselines: the segments sorted one after another, by std::sort or by 
+// the kernel of their size class.
+template <typename T>
+void stlSegments(T* keys, const std::size_t* offsets, std::size_t segments)
+{
+	for (std::size_t i = 0; i < segments; i++)
+		std::sort(keys + offsets[i], keys + offsets[i + 1]);
+}
+
+template <typename T>
+void loopSegments(T* keys, const std::size_t* offsets, std::size_t segments)
+{
+	for (std::size_t i = 0; i < segments; i++)
+		sortSegment(keys + offsets[i], keys + offsets[i + 1]);
+}
+
+// Benchmarks sorting the n keys as independent segments laid out by 
+// segmentShape around segmentMean keys.
+template <typename T, void(*S)(T*, const std::size_t*, std::size_t)>
+BenchStats benchSegments(int n, order type, const BenchConfig& cfg)
+{
+	const std::vector<std::size_t> offsets = segmentOffsets(n, segmentShape, segmentMean, testDataConfig().seed);
+	const std::size_t segments = offsets.size() - 1;
+	std::unique_ptr<T[]> source(constructTestArray<T>(n, type)), work(new T[n]);
+	std::size_t longest = 0;
+
+	for (std::size_t i = 0; i < segments; i++)
+		longest = std::max(longest, offsets[i + 1] - offsets[i]);
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { std::copy(source.get(), source.get() + n, work.get()); },
+			[&] { S(work.get(), offsets.data(), segments); },
+			[&] {
+				for (std::size_t i = 0; i < segments; i++)
+					if (!std::is_sorted(work.get() + offsets[i], work.get() + offsets[i + 1]))
+						throw std::runtime_error("segmented sort failed");
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, n);
+	std::cerr << "  " << segments << " segments, longest " << longest << std::endl;
+
+	return stats;
+}
+
+// Segmented sort strategies for element type T.
+template <typename T>
+std::vector<Algorithm> segmentAlgorithms()
+{
+	return {
+		{ "stl_loop",         benchSegments<T, stlSegments<T>>,                      MAX_ELEMENTS, nullptr },
+		{ "class_loop",       benchSegments<T, loopSegments<T>>,                     MAX_ELEMENTS, nullptr },
+		{ "segmented",        benchSegments<T, segmentedSort<T, std::size_t>>,       MAX_ELEMENTS, nullptr },
+		{ "segmented_global", benchSegments<T, segmentedSortGlobal<T, std::size_t>>, MAX_ELEMENTS, nullptr },
+	};
+}
+
+// Runs the segmented sort algorithms once per segment layout, naming each 
+// row's algorithm with the layout.
+template <typename T>
+void sweepSegments(const char* typeName, const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	segmentMean = opt.segmentMean;
+
+	for (SegmentShape shape : opt.segments)
+	{
+		const std::size_t first = rows.size();
+
+		segmentShape = shape;
+		sweepAlgorithms(segmentAlgorithms<T>(), typeName, sizeof(T), opt, rows);
+
+		for (std::size_t i = first; i < rows.size(); i++)
+			rows[i].algorithm += std::string("(") + segmentShapeName(shape) + " mean=" + std::to_string(segmentMean) + ")";
+	}
+}
+
+// Checks the sorts on tiny floating point arrays with NaN, infinities and
+// both zeros.  The radix sorts must give the IEEE total order of radixKey;
+// the comparison sorts must give a permutation of the input (NaN is
+// unordered under <, so its place is unspecified), losing no key.
+template <typename T>
+void verifyFloatKeys()
+{
+	typedef void (*Policy)(T*, T*);
+	const T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+	const T special[] = { T(3), nan, T(1), T(5), T(2), T(7), T(0), T(4), T(-0.0), -inf, inf, -nan, T(-1), T(11), T(3), T(-2.5) };
+	const Policy totalOrder[] = { radixSort<T>, radixSortArena<T>, radixSortWC<T>, pRadix<T>, parallelRadixSort<T> };
+	const Policy permutation[] = { tinySort<T>, networkSort<T>, quickSort<T>, sortSegment<T> };
+
+	auto ordered = [](std::vector<T> v) { std::sort(v.begin(), v.end(), RadixLess()); return v; };
+	auto same = [](const std::vector<T>& a, const std::vector<T>& b) { return !std::memcmp(a.data(), b.data(), a.size()*sizeof(T)); };
+
+	for (std::size_t n : { 8, 16, 20, 40, 64 })
+	{
+		std::vector<T> keys(n);
+
+		for (std::size_t i = 0; i < n; i++)
+			keys[i] = special[(7*i) % 16];
+
+		const std::vector<T> expected = ordered(keys);
+
+		for (Policy sort : totalOrder)
+		{
+			std::vector<T> work = keys;
+
+			sort(work.data(), work.data() + n);
+			if (!same(work, expected))
+				throw std::runtime_error("radix sort of NaN or signed zero keys failed");
+		}
+
+		for (Policy sort : permutation)
+		{
+			std::vector<T> work = keys;
+
+			sort(work.data(), work.data() + n);
+			if (!same(ordered(work), expected))
+				throw std::runtime_error("sort lost NaN or signed zero keys");
+		}
+	}
+}
+
+// Runs the selected sweep for element type T.
+template <typename T>
+void sweepType(const char* typeName, const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	if constexpr (std::is_floating_point<T>::value)
+		verifyFloatKeys<T>();
+
+	if (opt.calibrate)
+	{
+		const std::size_t maxN = opt.sizes.empty() ? 0 : *std::max_element(opt.sizes.begin(), opt.sizes.end());
+
+		std::cerr << "calibrating auto sort for " << typeName << std::endl;
+		autoSortTuning<T>() = calibrateAutoSort<T>(std::max<std::size_t>(maxN, std::size_t(1) << 16), opt.cfg);
+		reportTuning(std::cerr, typeName, autoSortTuning<T>());
+	}
+
+	if (!opt.file.input.empty())
+		sweepFile<T>(typeName, opt, rows);
+	else if (!opt.externalMB.empty())
+		sweepExternal<T>(typeName, opt, rows);
+	else if (!opt.topK.empty() || !opt.shards.empty() || !opt.batches.empty() || !opt.tiny.empty())
+		sweepCounts<T>(typeName, opt, rows);
+	else if (!opt.segments.empty())
+		sweepSegments<T>(typeName, opt, rows);
+	else
+		sweepAlgorithms(algorithms<T>(), typeName, sizeof(T), opt, rows);
+}
+
+// String sort strategies over std::string arrays.
+std::vector<Algorithm> stringAlgorithms()
+{
+	return {
+		{ "stl",          bench<std::string, stlSort<std::string>>,   1000000, nullptr },
+		{ "quick",        bench<std::string, quickSort<std::string>>, 1000000, nullptr },
+		{ "power",        bench<std::string, powerSort<std::string>>, 1000000, nullptr },
+		{ "msd_radix",    bench<std::string, msdRadixSort>,           1000000, nullptr },
+		{ "multikey",     bench<std::string, multikeyQuickSort>,      1000000, nullptr },
+		{ "lcp_merge",    bench<std::string, lcpMergeSort>,           1000000, nullptr },
+		{ "prefix_radix", bench<std::string, prefixRadixSort>,        1000000, nullptr },
+	};
+}
+
+// Runs the string sorts once per string shape, naming each row's 
+// algorithm with the shape.
+void sweepStrings(const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	for (StringShape shape : opt.strings)
+	{
+		const std::size_t first = rows.size();
+
+		testStringShape() = shape;
+		sweepAlgorithms(stringAlgorithms(), "string", sizeof(std::string), opt, rows);
+
+		for (std::size_t i = first; i < rows.size(); i++)
+			rows[i].algorithm += std::string("(") + stringShapeName(shape) + ")";
+	}
+}
+
+// Fat record: 32-bit key and P byte payload.
+template <std::size_t P>
+struct Record
+{
+	uint32_t key;
+	unsigned char payload[P];
+};
+
+template <std::size_t P>
+uint32_t recordKey(const Record<P>& r) { return r.key; }
+
+// Baseline: std::sort moves the whole records.
+template <std::size_t P>
+void stlRecords(Record<P>* begin, Record<P>* end)
+{
+	std::sort(begin, end, [](const Record<P>& a, const Record<P>& b) { return a.key < b.key; });
+}
+
+// Front-ends ordering the records by the key field (a pointer to member 
+// projection).
+template <std::size_t P>
+void quickByRecords(Record<P>* begin, Record<P>* end) { quickSortBy(begin, end, std::less<>(), &Record<P>::key); }
+
+template <std::size_t P>
+void radixByRecords(Record<P>* begin, Record<P>* end) { radixSortBy(begin, end, std::less<>(), &Record<P>::key); }
+
+// Stable sorts of the records by key.
+template <std::size_t P>
+void stlStableRecords(Record<P>* begin, Record<P>* end)
+{
+	std::stable_sort(begin, end, [](const Record<P>& a, const Record<P>& b) { return a.key < b.key; });
+}
+
+template <std::size_t P>
+void powerByRecords(Record<P>* begin, Record<P>* end) { powerSortBy(begin, end, std::less<>(), &Record<P>::key); }
+
+template <std::size_t P>
+void pStableRecords(Record<P>* begin, Record<P>* end)
+{
+	parallelStableSort(begin, end, [](const Record<P>& a, const Record<P>& b) { return a.key < b.key; });
+}
+
+template <std::size_t P>
+void pRadixRecords(Record<P>* begin, Record<P>* end) { parallelRadixSortKeyed(begin, end, recordKey<P>); }
+
+// Argsort the keys, then move each record once.
+template <std::size_t P, void(*A)(const uint32_t*, std::size_t, uint32_t*)>
+void argsortRecords(Record<P>* begin, Record<P>* end) { sortRecords<Record<P>, uint32_t, recordKey<P>, A>(begin, end); }
+
+// Benchmarks sorting n records with a P byte payload.  A stable sort must
+// also keep records of equal keys in input order.
+template <std::size_t P, void(*S)(Record<P>*, Record<P>*), bool STABLE = false>
+BenchStats benchRecords(int n, order type, const BenchConfig& cfg)
+{
+	std::unique_ptr<uint32_t[]> keys(constructTestArray<uint32_t>(n, type));
+	std::unique_ptr<Record<P>[]> source(new Record<P>[n]), work(new Record<P>[n]);
+
+	// Tag each payload with its key, so a payload separated from its key is
+	// detected, and start it with the input position.
+	for (int i = 0; i < n; i++)
+	{
+		const uint32_t index = uint32_t(i);
+
+		source[i].key = keys[i];
+		std::fill(source[i].payload, source[i].payload + P, static_cast<unsigned char>(keys[i]));
+		std::memcpy(source[i].payload, &index, sizeof(index));
+	}
+
+	auto position = [](const Record<P>& r) { uint32_t i; std::memcpy(&i, r.payload, sizeof(i)); return i; };
+
+	BenchStats stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+		return timedRun(
+			[&] { std::copy(source.get(), source.get() + n, work.get()); },
+			[&] { S(work.get(), work.get() + n); },
+			[&] {
+				for (int i = 0; i < n; i++)
+				{
+					if ((i && work[i].key < work[i - 1].key) || work[i].payload[P - 1] != static_cast<unsigned char>(work[i].key))
+						throw std::runtime_error("record sort failed");
+					if (STABLE && i && work[i].key == work[i - 1].key && position(work[i]) < position(work[i - 1]))
+						throw std::runtime_error("record sort not stable");
+				}
+			},
+			counters, perf);
+	}, cfg);
+
+	reportStats(stats, cfg, n);
+
+	return stats;
+}
+
+// Record sort strategies for payload size P.
+template <std::size_t P>
+std::vector<Algorithm> recordAlgorithms()
+{
+	return {
+		{ "stl",           benchRecords<P, stlRecords<P>>,                                   MAX_ELEMENTS, nullptr },
+		{ "quick_by",      benchRecords<P, quickByRecords<P>>,                               MAX_ELEMENTS, nullptr },
+		{ "radix_by",      benchRecords<P, radixByRecords<P>, true>,                         MAX_ELEMENTS, nullptr },
+		{ "stl_stable",    benchRecords<P, stlStableRecords<P>, true>,                       MAX_ELEMENTS, nullptr },
+		{ "power_by",      benchRecords<P, powerByRecords<P>, true>,                         MAX_ELEMENTS, nullptr },
+		{ "pstable",       benchRecords<P, pStableRecords<P>, true>,                         MAX_ELEMENTS, nullptr },
+		{ "pradix_stable", benchRecords<P, pRadixRecords<P>, true>,                          MAX_ELEMENTS, nullptr },
+		{ "stl_argsort",   benchRecords<P, argsortRecords<P, stlArgsort<uint32_t>>, true>,   MAX_ELEMENTS, nullptr },
+		{ "radix_argsort", benchRecords<P, argsortRecords<P, radixArgsort<uint32_t>>, true>, MAX_ELEMENTS, nullptr },
+		{ "p_argsort",     benchRecords<P, argsortRecords<P, pArgsort<uint32_t>>, true>,     MAX_ELEMENTS, nullptr },
+	};
+}
+
+// Runs the selected record sweep for payload size P.
+template <std::size_t P>
+void sweepRecords(const SweepOptions& opt, std::vector<ResultRow>& rows)
+{
+	sweepAlgorithms(recordAlgorithms<P>(), "record" + std::to_string(P), sizeof(Record<P>), opt, rows);
+}
+
+// Prints command line usage.
+void usage(const char* prog)
+{
+	std::cerr << "usage: " << prog << " [options]\n"
+		"  --algos a,b,...   stl,heap,insertion,comb,counting,counting_arena,pcounting,radix,\n"
+		"                    radix_arena,radix_wc,radix_by,radix_desc,pradix,psort,quick,\n"
+		"                    quick_by,quick_desc,power,power_by,stl_stable,pstl_stable,\n"
+		"                    pstable,pradix_stable,simd,sample,numa,auto\n"
+		"                    (*_by and *_desc sort a std::vector through the comparator\n"
+		"                    front-ends, ascending and descending)\n"
+		"                    (default all)\n"
+		"  --sizes n,m,...   element counts (default " << MIN_ELEMENTS << ".." << MAX_ELEMENTS << " by decades)\n"
+		"  --types t,...     int32,uint32,int64,uint64,float,double (default int32)\n"
+		"  --records p,...   sort key + p byte payload records instead, p in 8,16,24,32,48,64\n"
+		"                    (algos stl,quick_by,radix_by,stl_stable,power_by,pstable,\n"
+		"                    pradix_stable,stl_argsort,radix_argsort,p_argsort; the\n"
+		"                    stable ones are checked for stability)\n"
+		"  --topk k,...      find the k smallest keys instead (algos stl_partial_sort,\n"
+		"                    stl_nth_element,ptopk,pselect)\n"
+		"  --merge r,...     merge r sorted runs of the keys instead (algos stl_sort,\n"
+		"                    stl_merge,loser_merge,pmerge)\n"
+		"  --lsm b,...       append the keys in batches of b to a sorted array instead\n"
+		"                    (algos resort,merge,lsm)\n"
+		"  --tiny k,...      sort the keys as many arrays of k keys instead, reporting\n"
+		"                    sorts/sec (algos stl,insertion,quick,radix,counting,network)\n"
+		"  --segments s,...  sort the keys as independent segments instead, with lengths\n"
+		"                    uniform, power (heavy tailed) or one_big (half the keys in\n"
+		"                    one segment) (algos stl_loop,class_loop,segmented,\n"
+		"                    segmented_global)\n"
+		"  --segment-mean m  mean segment length (default 16)\n"
+		"  --strings s,...   sort std::strings instead: url, ident (identifiers), words,\n"
+		"                    random (alphanumeric) or prefix (64 shared characters)\n"
+		"                    (algos stl,quick,power,msd_radix,multikey,lcp_merge,\n"
+		"                    prefix_radix)\n"
+		"  --orders o,...    random,ordered,reversed,mostly_ordered,zipf,few_unique,\n"
+		"                    sawtooth,organ_pipe,k_inversions (default random)\n"
+		"  --seed s          test data seed; equal seeds give equal inputs (default 1)\n"
+		"  --inversions k    adjacent swaps of k_inversions (default sqrt(n))\n"
+		"  --format f        csv or json (default csv)\n"
+		"  --out file        write results to file (default stdout)\n"
+		"  --min-trials k    minimum timed trials per cell\n"
+		"  --max-trials k    maximum timed trials per cell\n"
+		"  --max-seconds s   time budget per cell\n"
+		"  --no-limits       run quadratic kernels at every size\n"
+		"  --threads k       worker threads of the sample sort pool and of test data\n"
+		"                    generation (default one per CPU)\n"
+		"  --pin             pin pool threads one per CPU\n"
+		"  --numa            place each work array's pages by NUMA node before timing, and\n"
+		"                    report local and remote bandwidth\n"
+		"  --calibrate       time the kernels on this host to set the auto sort\n"
+		"                    thresholds (otherwise defaults are used)\n"
+		"  --counters        read hardware performance counters (Linux)\n"
+		"  --simd-level l    limit simd sort to scalar,sse4,avx2 or avx512\n"
+		"  --external mb,... external sort of generated files of mb megabytes instead,\n"
+		"                    runs sorted by algos radix,psort,stl (default radix)\n"
+		"  --memory-mb m     external sort memory budget (default 256)\n"
+		"  --temp-dir d      external sort data and run file directory (default .)\n"
+		"  --file path       sort the keys of a binary file (of --types) through mmap,\n"
+		"                    timing map, sort and write-back; the file is unchanged\n"
+		"  --file-out path   copy the keys to a mapped output file and sort it there\n"
+		"  --in-place        sort the --file in place (one algorithm and type)\n"
+		"  --hugepages       advise huge pages for the sorted mapping\n"
+		"Without options the interactive single-size benchmark runs.\n";
+}
+
+// Command line driven sweep writing CSV/JSON results.
+int sweep(int argc, char** argv)
+{
+	SweepOptions opt;
+	opt.cfg.report = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool hasValue = (i + 1 < argc);
+
+		if (arg == "--no-limits")
+			opt.noLimits = true;
+		else if (arg == "--calibrate")
+			opt.calibrate = true;
+		else if (arg == "--pin")
+			opt.pin = true;
+		else if (arg == "--numa")
+			opt.cfg.firstTouch = numaFirstTouch;
+		else if (arg == "--in-place")
+			opt.file.inPlace = true;
+		else if (arg == "--hugepages")
+			opt.file.hugePages = true;
+		else if (arg == "--counters")
+			opt.cfg.counters = true;
+		else if (arg == "--help" || !hasValue)
+		{
+			usage(argv[0]);
+			return (arg == "--help") ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+		else if (arg == "--algos")
+			opt.algorithms = splitList(argv[++i]);
+		else if (arg == "--sizes")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+				opt.sizes.push_back(std::stoi(v));
+		}
+		else if (arg == "--types")
+			opt.types = splitList(argv[++i]);
+		else if (arg == "--records")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+				opt.payloads.push_back(std::stoi(v));
+		}
+		else if (arg == "--topk")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+				opt.topK.push_back(std::stoi(v));
+		}
+		else if (arg == "--merge")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+				opt.shards.push_back(std::stoi(v));
+		}
+		else if (arg == "--lsm")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+				opt.batches.push_back(std::stoi(v));
+		}
+		else if (arg == "--tiny")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+				opt.tiny.push_back(std::stoi(v));
+		}
+		else if (arg == "--segments")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+			{
+				const SegmentShape all[] = { SEGMENT_UNIFORM, SEGMENT_POWER, SEGMENT_ONE_BIG };
+				const SegmentShape* s = std::find_if(std::begin(all), std::end(all), [&](SegmentShape x) { return v == segmentShapeName(x); });
+
+				if (s == std::end(all))
+				{
+					std::cerr << "unknown segment shape: " << v << std::endl;
+					return EXIT_FAILURE;
+				}
+
+				opt.segments.push_back(*s);
+			}
+		}
+		else if (arg == "--strings")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+			{
+				const StringShape all[] = { STRING_URL, STRING_IDENT, STRING_WORDS, STRING_RANDOM, STRING_PREFIX };
+				const StringShape* s = std::find_if(std::begin(all), std::end(all), [&](StringShape x) { return v == stringShapeName(x); });
+
+				if (s == std::end(all))
+				{
+					std::cerr << "unknown string shape: " << v << std::endl;
+					return EXIT_FAILURE;
+				}
+
+				opt.strings.push_back(*s);
+			}
+		}
+		else if (arg == "--segment-mean")
+			opt.segmentMean = std::size_t(std::stoul(argv[++i]));
+		else if (arg == "--orders")
+		{
+			opt.orders.clear();
+			for (const std::string& v : splitList(argv[++i]))
+			{
+				const order all[] = { order::ORDERED, order::REVERSED, order::MOSTLY_ORDERED, order::RANDOM, order::ZIPF,
+					order::FEW_UNIQUE, order::SAWTOOTH, order::ORGAN_PIPE, order::K_INVERSIONS };
+				const order* o = std::find_if(std::begin(all), std::end(all), [&](order x) { return v == orderName(x); });
+
+				if (o == std::end(all))
+				{
+					std::cerr << "unknown order: " << v << std::endl;
+					return EXIT_FAILURE;
+				}
+
+				opt.orders.push_back(*o);
+			}
+		}
+		else if (arg == "--threads")
+			opt.threads = std::stoi(argv[++i]);
+		else if (arg == "--seed")
+			testDataConfig().seed = std::stoull(argv[++i]);
+		else if (arg == "--inversions")
+			testDataConfig().inversions = std::stoull(argv[++i]);
+		else if (arg == "--format")
+			opt.format = argv[++i];
+		else if (arg == "--out")
+			opt.out = argv[++i];
+		else if (arg == "--min-trials")
+			opt.cfg.minTrials = std::stoi(argv[++i]);
+		else if (arg == "--max-trials")
+			opt.cfg.maxTrials = std::stoi(argv[++i]);
+		else if (arg == "--max-seconds")
+			opt.cfg.maxSeconds = std::stod(argv[++i]);
+		else if (arg == "--external")
+		{
+			for (const std::string& v : splitList(argv[++i]))
+				opt.externalMB.push_back(std::stoi(v));
+		}
+		else if (arg == "--memory-mb")
+			opt.external.memoryBytes = std::size_t(std::stoi(argv[++i])) << 20;
+		else if (arg == "--temp-dir")
+			opt.external.tempDir = argv[++i];
+		else if (arg == "--file")
+			opt.file.input = argv[++i];
+		else if (arg == "--file-out")
+			opt.file.output = argv[++i];
+		else if (arg == "--simd-level")
+		{
+			const std::string v = argv[++i];
+			const simdLevel all[] = { SIMD_NONE, SIMD_SSE4, SIMD_AVX2, SIMD_AVX512 };
+			const simdLevel* l = std::find_if(std::begin(all), std::end(all), [&](simdLevel x) { return v == simdLevelName(x); });
+
+			if (l == std::end(all))
+			{
+				std::cerr << "unknown simd level: " << v << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			limitSimdLevel(*l);
+		}
+		else
+		{
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (opt.sizes.empty())
+		for (int n = MIN_ELEMENTS; n <= MAX_ELEMENTS; n *= 10)
+			opt.sizes.push_back(n);
+
+	if (opt.threads < 0)
+	{
+		std::cerr << "invalid thread count: " << opt.threads << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	configureSortPool(unsigned(opt.threads), opt.pin);
+	testDataConfig().threads = unsigned(opt.threads);
+
+	if (opt.cfg.firstTouch)
+		reportNumaBandwidth(std::cerr, numaContext().topology(), measureNumaBandwidth());
+
+	if (opt.format != "csv" && opt.format != "json")
+	{
+		std::cerr << "unknown format: " << opt.format << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	for (const std::string& a : opt.algorithms)
+	{
+		const std::vector<Algorithm> all = !opt.payloads.empty() ? recordAlgorithms<8>() : !opt.strings.empty() ? stringAlgorithms() 
+			: !opt.topK.empty() ? selectAlgorithms<int>()
+			: !opt.shards.empty() ? mergeAlgorithms<int>() : !opt.batches.empty() ? appendAlgorithms<int>() 
+			: !opt.tiny.empty() ? tinyAlgorithms<int>() : !opt.segments.empty() ? segmentAlgorithms<int>() : algorithms<int>();
+
+		if (std::none_of(all.begin(), all.end(), [&](const Algorithm& x) { return a == x.name; }))
+		{
+			std::cerr << "unknown algorithm: " << a << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (opt.file.inPlace && (opt.algorithms.size() != 1 || opt.types.size() != 1 || !opt.file.output.empty()))
+	{
+		std::cerr << "--in-place needs one --algos and one --types, and no --file-out" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<ResultRow> rows;
+
+	try {
+		for (int p : opt.payloads)
+		{
+			switch (p)
+			{
+				case 8:  sweepRecords<8>(opt, rows); break;
+				case 16: sweepRecords<16>(opt, rows); break;
+				case 24: sweepRecords<24>(opt, rows); break;
+				case 32: sweepRecords<32>(opt, rows); break;
+				case 48: sweepRecords<48>(opt, rows); break;
+				case 64: sweepRecords<64>(opt, rows); break;
+				default:
+					std::cerr << "unsupported payload size: " << p << std::endl;
+					return EXIT_FAILURE;
+			}
+		}
+
+		if (!opt.strings.empty())
+			sweepStrings(opt, rows);
+
+		for (const std::string& t : (opt.payloads.empty() && opt.strings.empty()) ? opt.types : std::vector<std::string>())
+		{
+			if (t == "int32")
+				sweepType<int32_t>("int32", opt, rows);
+			else if (t == "uint32")
+				sweepType<uint32_t>("uint32", opt, rows);
+			else if (t == "int64")
+				sweepType<int64_t>("int64", opt, rows);
+			else if (t == "uint64")
+				sweepType<uint64_t>("uint64", opt, rows);
+			else if (t == "float")
+				sweepType<float>("float", opt, rows);
+			else if (t == "double")
+				sweepType<double>("double", opt, rows);
+			else
+			{
+				std::cerr << "unknown type: " << t << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::cerr << "Encountered exception: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	fitExponents(rows);
+
+	std::ofstream file;
+	if (!opt.out.empty())
+	{
+		file.open(opt.out);
+		if (!file)
+		{
+			std::cerr << "cannot open " << opt.out << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::ostream& os = opt.out.empty() ? std::cout : file;
+
+	if (opt.format == "json")
+		writeJson(os, rows);
+	else
+		writeCsv(os, rows);
+
+	return EXIT_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
+	// Any command line option selects the results sweep.
+	if (argc > 1)
+		return sweep(argc, argv);
+
 #ifndef REDIRECT_TO_FILE
 	// input message
 	std::cout << "Please enter the number of elements you want to inserted into an array: " << std::endl;
@@ -151,13 +1469,13 @@ int main(int argc, char** argv)
 				Sort<int, pSort> psort;
 				psort.benchmark(numOfElements, order::RANDOM);
 			}
-
+#endif
 			{
-				std::cout << "PPL Parallel Radix ";
+				std::cout << "Parallel Radix ";
 				Sort<int, pRadix> pRadx;
 				pRadx.benchmark(numOfElements, order::RANDOM);
 			}
-#endif
+
 #if (__cpp_lib_parallel_algorithm >= 201603)
 			{
 				std::cout << "Parallel C++17 STL sort() ";
@@ -165,12 +1483,39 @@ int main(int argc, char** argv)
 				psort.benchmark(numOfElements, order::RANDOM);
 			}
 #endif
+			{
+				std::cout << "Parallel Sample (" << sortPool().size() << " threads) ";
+				Sort<int, sampleSort> sample;
+				sortPool().resetStats();
+				sample.benchmark(numOfElements, order::RANDOM);
+				reportLoadBalance(std::cout, sortPool().stats());
+			}
+
+			{
+				std::cout << "NUMA Sample (" << numaContext().nodes() << " nodes) ";
+				Sort<int, numaSort> numa;
+				numa.benchmark(numOfElements, order::RANDOM);
+			}
+
 			{
 				std::cout << "Quick ";
 				Sort<int, quickSort> quick;
 				quick.benchmark(numOfElements, order::RANDOM);
 			}
 
+			{
+				std::unique_ptr<int[]> sample(constructTestArray<int>(numOfElements, order::RANDOM));
+				std::cout << "Auto (" << autoKernelName(autoKernelFor(sample.get(), sample.get() + numOfElements)) << ") ";
+				Sort<int, autoSort> automatic;
+				automatic.benchmark(numOfElements, order::RANDOM);
+			}
+
+			{
+				std::cout << "SIMD Quick (" << simdLevelName(simdDispatch()) << ") ";
+				Sort<int, simdSort> simd;
+				simd.benchmark(numOfElements, order::RANDOM);
+			}
+
 			//
 			// Part 3: Ordered sort values.
 			//
@@ -181,6 +1526,12 @@ int main(int argc, char** argv)
 				quick.benchmark(numOfElements, order::ORDERED);
 			}
 
+			{
+				std::cout << "Powersort on a mostly ordered array ";
+				Sort<int, powerSort> power;
+				power.benchmark(numOfElements, order::MOSTLY_ORDERED);
+			}
+
 		}
 		catch (std::exception& e)
 		{
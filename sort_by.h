@@ -0,0 +1,123 @@
+/*************************************************************************
+* Title: Comparator and Projection Sort Front-Ends.
+* File: sort_by.h
+* Date: 10/16/2026
+*
+* Sort policies over any contiguous iterator range, ordered by a
+* comparator applied to a projection of each element:
+*   STL sort (stlSortBy)
+*   STL heap sort (heapSortBy)
+*   insertion sort (insertionSortBy)
+*   comb sort (combSortBy)
+*   pattern-defeating quicksort (quickSortBy)
+*   run-adaptive stable merge sort (powerSortBy)
+*   radix sort with a compile-time digit function (radixSortBy)
+*
+* Notes:
+*  (1) Iterators must be contiguous (pointers, std::vector, std::array
+*      or std::string iterators); the T* kernels of sort_funcs.h run on
+*      the underlying array.
+*  (2) The comparator and projection are template parameters, so each
+*      combination is a separate instantiation with both calls inlined.
+*      With the default std::less<> and Identity the kernel is given the
+*      comparator alone and compiles to the same code as the plain T*
+*      kernel.
+*  (3) A projection is a callable or a pointer to member (std::invoke),
+*      e.g. &Record::key.  It is applied on every comparison, so it
+*      should be cheap, like reading a field.
+*  (4) radixSortBy turns std::less or std::greater over an arithmetic
+*      projected key into a digit function at compile time: radixKey of
+*      the key, or its complement for descending order.  Any other
+*      comparator or key type falls back to quickSortBy, which is not
+*      stable.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _SORT_BY_H_
+#define _SORT_BY_H_
+
+// Comparator of the kernels: comp itself for the identity projection,
+// otherwise comp applied to both projections.
+template <typename Compare, typename Proj>
+ProjectedCompare<Compare, Proj> projectedCompare(Compare comp, Proj proj) { return { comp, proj }; }
+
+template <typename Compare>
+Compare projectedCompare(Compare comp, Identity) { return comp; }
+
+// First element of a non-empty contiguous range as a pointer.
+template <typename It>
+auto rangeData(It first) { return std::addressof(*first); }
+
+template <typename It, typename Compare = std::less<>, typename Proj = Identity>
+void stlSortBy(It first, It last, Compare comp = Compare(), Proj proj = Proj())
+{
+	if (first != last)
+		stlSort(rangeData(first), rangeData(first) + (last - first), projectedCompare(comp, proj));
+}
+
+template <typename It, typename Compare = std::less<>, typename Proj = Identity>
+void heapSortBy(It first, It last, Compare comp = Compare(), Proj proj = Proj())
+{
+	if (first != last)
+		heapSort(rangeData(first), rangeData(first) + (last - first), projectedCompare(comp, proj));
+}
+
+template <typename It, typename Compare = std::less<>, typename Proj = Identity>
+void insertionSortBy(It first, It last, Compare comp = Compare(), Proj proj = Proj())
+{
+	if (first != last)
+		insertionSort(rangeData(first), rangeData(first) + (last - first), projectedCompare(comp, proj));
+}
+
+template <typename It, typename Compare = std::less<>, typename Proj = Identity>
+void combSortBy(It first, It last, Compare comp = Compare(), Proj proj = Proj())
+{
+	if (first != last)
+		combSort(rangeData(first), rangeData(first) + (last - first), projectedCompare(comp, proj));
+}
+
+template <typename It, typename Compare = std::less<>, typename Proj = Identity>
+void quickSortBy(It first, It last, Compare comp = Compare(), Proj proj = Proj())
+{
+	if (first != last)
+		quickSort(rangeData(first), rangeData(first) + (last - first), projectedCompare(comp, proj));
+}
+
+template <typename It, typename Compare = std::less<>, typename Proj = Identity>
+void powerSortBy(It first, It last, Compare comp = Compare(), Proj proj = Proj())
+{
+	if (first != last)
+		powerSort(rangeData(first), rangeData(first) + (last - first), projectedCompare(comp, proj));
+}
+
+/*************************************************************************
+ * Radix sort by a projected key. The digit function is chosen from the
+ * comparator type at compile time (no per-element indirect calls).
+ *************************************************************************/
+template <typename It, typename Compare = std::less<>, typename Proj = Identity>
+void radixSortBy(It first, It last, Compare comp = Compare(), Proj proj = Proj())
+{
+	typedef typename std::remove_reference<decltype(*first)>::type T;
+	typedef typename std::decay<typename std::invoke_result<Proj, const T&>::type>::type K;
+	constexpr int DIRECTION = compareDirection<Compare>::value;
+
+	if (first == last)
+		return;
+
+	if constexpr (std::is_arithmetic<K>::value && !std::is_same<K, bool>::value && DIRECTION != 0)
+	{
+		T* begin = rangeData(first);
+		T* end = begin + (last - first);
+		std::unique_ptr<T[]> buffer(new T[last - first]);
+
+		if constexpr (DIRECTION > 0)
+			radixSortKeyed(begin, end, buffer.get(), [proj](const T& x) { return radixKey(K(std::invoke(proj, x))); });
+		else
+			radixSortKeyed(begin, end, buffer.get(), [proj](const T& x) { return typename radixBits<K>::type(~radixKey(K(std::invoke(proj, x)))); });
+	}
+	else
+		quickSortBy(first, last, comp, proj);
+}
+
+#endif
@@ -11,16 +11,23 @@
 *   insertion sort (insertionSort)
 *   comb sort (combSort)
 *   counting sort (countingSort)
-*   quick sort (quickSort)
+*   pattern-defeating quicksort (quickSort)
+*   run-adaptive stable merge sort (powerSort)
 *   radix sort (radixSort)
 *   parallel radix sort (pRadix)
+*   parallel counting sort (pCounting)
 *   parallel quicksort (psort)
+*   scratch arena radix and counting sorts (radixSortArena, countingSortArena)
+*   argsort variants (radixArgsort, stlArgsort, pArgsort)
+*   key-value and record sorting by permutation (sortByKey, sortRecords)
 *
 * Notes:
 *  (1) Insertion, comb, counting and quicksort adapted from the textbook 
 *      "Data Structures and Algorithms in C++", 4th edition, by Drozdek.
+*      Quicksort since reworked after Orson Peters' pdqsort.
 *  (2) Uses C++17 parallel algorithm feature for sort(), otherwise 
 *      substitutes a concurrent MSVC++ Parallel Patterns Library version.
+*      The parallel radix sort uses std::thread and runs on any platform.
 *  (3) For most accurate timing results, use Release build.
 *  (4) Compiled/tested with MS Visual Studio 2017 Community (v141), and
 *      Windows SDK version 10.0.17134.0
@@ -30,6 +37,23 @@
 * Submitted in partial fulfillment of the requirements of PCC CIS-269.
 *************************************************************************
 * Change Log:
+*   10/16/2026: Tiny radix sorts order by radixKey (NaN, -0 total order).
+*   10/16/2026: Stability trait of the sort policies.
+*   10/16/2026: Sorting network leaves in quickSort; tiny arrays skip the
+*               radix and counting sort passes.
+*   10/16/2026: Comparator overloads of the comparison sorts; keyed radix sort.
+*   10/16/2026: Seeded, parallel test data; add zipf, few unique, sawtooth,
+*               organ pipe and k inversions orders.
+*   10/16/2026: Optional first touch of the benchmark work array.
+*   10/16/2026: Add parallel counting sort; radix fallback for wide key ranges.
+*   10/16/2026: Add run-adaptive powersort.
+*   10/16/2026: Replace first-element pivot quicksort with pdqsort.
+*   10/16/2026: Scratch arena overloads of radix and counting sort.
+*   10/16/2026: Add argsort, key-value and record sorting.
+*   10/16/2026: Signed, floating point and 64-bit count support in radix sorts.
+*   10/16/2026: Replace PPL-only pRadix with a portable threaded radix sort.
+*   10/16/2026: Optional hardware performance counters in benchmark.
+*   10/16/2026: Repeated, adaptive trials with summary statistics in benchmark.
 *   11/29/2018: Add C++17 parallel algorithm sort. JME
 *   11/16/2018: Initial release. JME
 *************************************************************************/
@@ -45,279 +69,1204 @@ template <typename T> void heapSort(T*, T*);      // STL heap sort algorithm.
 template <typename T> void insertionSort(T*, T*); // My insertion sort.
 template <typename T> void combSort(T*, T*);      // My comb sort algorithm.
 template <typename T> void countingSort(T*, T*);  // My counting sort algorithm.
-template <typename T> void quickSort(T*, T*);     // My quicksort algorithm.
+template <typename T> void quickSort(T*, T*);     // My pattern-defeating quicksort algorithm.
+template <typename T> void powerSort(T*, T*);     // My run-adaptive merge sort.
 template <typename T> void radixSort(T*, T*);     // My optimized radix sort (based on EASTL) algorithm.
 template <typename T> void pSort(T*, T*);         // PPL or STL C++17 parallel sort algorithm.
+template <typename T> void pRadix(T*, T*);        // My multi-threaded radix sort.
+template <typename T> void pCounting(T*, T*);     // My multi-threaded counting sort.
+template <typename T> void radixSortArena(T*, T*);    // Radix sort using a per-thread scratch arena.
+template <typename T> void countingSortArena(T*, T*); // Counting sort using a per-thread scratch arena.
+template <typename T> void networkSort(T*, T*);   // Sorting networks for tiny arrays, else quicksort.
+template <typename T, typename Compare> void tinySort(T*, T*, Compare); // Sorting network sort of at most 64 keys.
+template <typename T, void (*S)(T*, T*)> struct isStableSort;                // Stability of a sort policy (stable_sort.h).
+
+// Sorting network sizes (tiny_sort.h).
+constexpr std::size_t NETWORK_MAX{ 32 };   // Largest sorting network.
+constexpr std::size_t TINY_SORT_MAX{ 64 }; // Largest tinySort, two networks and a merge.
+
+// Argsort (sorting permutation) prototypes.
+template <typename K, typename I = uint32_t> void radixArgsort(const K*, std::size_t, I*); // Radix sort of (key, index) pairs.
+template <typename K, typename I = uint32_t> void stlArgsort(const K*, std::size_t, I*);   // STL sort of (key, index) pairs.
+template <typename K, typename I = uint32_t> void pArgsort(const K*, std::size_t, I*);     // Parallel sort of (key, index) pairs.
 #if (_MSC_VER && __cpp_lib_parallel_algorithm < 201603)
 inline float LogN(float);                         // Parallel quicksort helper function.
-template <typename T> void pRadix(T*, T*);        // PPL parallel radix sort.
 #endif
 
+// Projection that returns the element itself.
+struct Identity
+{
+	template <typename T>
+	constexpr T&& operator() (T&& x) const noexcept { return std::forward<T>(x); }
+};
+
+// Orders elements by comparing their projections (a callable or a 
+// pointer to member).
+template <typename Compare, typename Proj>
+struct ProjectedCompare
+{
+	Compare comp;
+	Proj proj;
+
+	template <typename T>
+	bool operator() (const T& a, const T& b) const { return comp(std::invoke(proj, a), std::invoke(proj, b)); }
+};
+
+// Key order of a comparator known at compile time: 1 for std::less, -1 
+// for std::greater, 0 for any other comparator.
+template <typename Compare> struct compareDirection : std::integral_constant<int, 0> { };
+template <typename K> struct compareDirection<std::less<K>> : std::integral_constant<int, 1> { };
+template <typename K> struct compareDirection<std::greater<K>> : std::integral_constant<int, -1> { };
+
+// True if Compare orders T by a plain comparison of arithmetic keys, so 
+// comparisons are cheap and branchless partitioning pays off.
+template <typename T, typename Compare>
+struct cheapCompare : std::integral_constant<bool, std::is_arithmetic<T>::value && compareDirection<Compare>::value != 0> { };
+
+template <typename T, typename Compare, typename Proj>
+struct cheapCompare<T, ProjectedCompare<Compare, Proj>> 
+	: std::integral_constant<bool, std::is_arithmetic<typename std::decay<typename std::invoke_result<Proj, const T&>::type>::type>::value 
+		&& compareDirection<Compare>::value != 0> { };
+
+// Uniform random distribution for integral or floating point T.
+template <typename T>
+using uniformDistribution = typename std::conditional<std::is_floating_point<T>::value, 
+	std::uniform_real_distribution<T>, std::uniform_int_distribution<T>>::type;
+
+// Multi-threading helper (defined with the parallel sorts below).
+template <typename F> void forEachThread(std::size_t, F);
+
 // Defines element order of benchmark array.
-enum order { ORDERED, REVERSED, MOSTLY_ORDERED, RANDOM };
+enum order { ORDERED, REVERSED, MOSTLY_ORDERED, RANDOM, ZIPF, FEW_UNIQUE, SAWTOOTH, ORGAN_PIPE, K_INVERSIONS };
+
+// Printable name of an element order.
+inline const char* orderName(order type)
+{
+	switch (type)
+	{
+		case order::ORDERED:        return "ordered";
+		case order::REVERSED:       return "reversed";
+		case order::MOSTLY_ORDERED: return "mostly_ordered";
+		case order::ZIPF:           return "zipf";
+		case order::FEW_UNIQUE:     return "few_unique";
+		case order::SAWTOOTH:       return "sawtooth";
+		case order::ORGAN_PIPE:     return "organ_pipe";
+		case order::K_INVERSIONS:   return "k_inversions";
+		case order::RANDOM:
+		default:                    return "random";
+	}
+}
+
+// Seed and shape of generated benchmark inputs.
+struct TestDataConfig
+{
+	uint64_t seed = 1;          // Same seed, same keys (at any thread count).
+	std::size_t inversions = 0; // Adjacent swaps of k_inversions; 0 is sqrt(n).
+	unsigned threads = 0;       // Fill threads; 0 is one per CPU.
+};
+
+inline TestDataConfig& testDataConfig()
+{
+	static TestDataConfig cfg;
+
+	return cfg;
+}
+
+constexpr std::size_t FEW_UNIQUE_KEYS{ 16 };           // Distinct keys of few_unique.
+constexpr std::size_t SAWTOOTH_TEETH{ 16 };            // Ascending runs of sawtooth.
+constexpr std::size_t FILL_PER_THREAD{ std::size_t(1) << 16 }; // Smallest parallel fill share.
+
+// SplitMix64 finalizer.
+inline uint64_t splitmix64(uint64_t x)
+{
+	x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+
+	return x ^ (x >> 31);
+}
+
+// Random 64 bits number i of the stream key: a pure function of both, so
+// any split of the indices among threads yields the same keys.
+inline uint64_t counterRandom(uint64_t key, uint64_t i) { return splitmix64(key + (i + 1)*0x9e3779b97f4a7c15ULL); }
+
+// Uniform index in [0, range) from the high 32 bits of r (range <= 2^32).
+inline uint64_t randomBelow(uint64_t r, uint64_t range) { return ((r >> 32)*range) >> 32; }
+
+/*************************************************************************
+ * Fills a[0, count) with the keys at indices [first, first + count) of an
+ * n key input of the given order, in parallel.  Keys are a function of
+ * (seed, index), so the result does not depend on the thread count, and
+ * each order's loop is branch free for vectorization.  Swaps of the 
+ * mostly ordered and k inversions orders are applied by applyTestSwaps.
+ *************************************************************************/
+template <typename T>
+void fillTestKeys(T* a, std::size_t first, std::size_t count, std::size_t n, order type, uint64_t seed)
+{
+	const TestDataConfig& cfg = testDataConfig();
+	const std::size_t threads = std::max<std::size_t>(1, std::min<std::size_t>(cfg.threads ? cfg.threads
+		: std::max(1u, std::thread::hardware_concurrency()), count/FILL_PER_THREAD));
+	const uint64_t key = splitmix64(seed);
+
+	// Random range [0, n], or [-n/2, n/2] for signed and floating point 
+	// types, so negative keys are exercised.
+	const bool isSigned = std::is_signed<T>::value;
+	const long long lo = isSigned ? -(long long)(n/2) : 0;
+	const uint64_t span = n + 1;
+
+	auto fill = [&](auto f) {
+		forEachThread(threads, [&](std::size_t t) {
+			for (std::size_t i = count*t/threads, last = count*(t + 1)/threads; i < last; i++)
+				a[i] = f(first + i);
+		});
+	};
+
+	switch (type)
+	{
+		case order::ORDERED:
+		case order::MOSTLY_ORDERED:
+		case order::K_INVERSIONS:
+			fill([](std::size_t i) { return T(i + 1); });
+			break;
+
+		case order::REVERSED:
+			fill([n](std::size_t i) { return T(n - i); });
+			break;
+
+		case order::SAWTOOTH:
+		{
+			const std::size_t period = std::max<std::size_t>(1, (n + SAWTOOTH_TEETH - 1)/SAWTOOTH_TEETH);
+
+			fill([period](std::size_t i) { return T(i % period + 1); });
+			break;
+		}
+
+		case order::ORGAN_PIPE:
+			fill([n](std::size_t i) { return T(std::min(i, n - 1 - i) + 1); });
+			break;
+
+		case order::ZIPF:
+		{
+			// Rank r in [1, n] with probability log((r + 1)/r)/log(n + 1),
+			// close to Zipf's 1/r.
+			const double logRange = std::log(double(n) + 1.0);
+
+			fill([=](std::size_t i) {
+				const double u = double(counterRandom(key, i) >> 11)*0x1.0p-53;
+
+				return T(std::min<double>(std::floor(std::exp(u*logRange)), double(n)));
+			});
+			break;
+		}
+
+		case order::FEW_UNIQUE:
+		{
+			const double step = double(span - 1)/(FEW_UNIQUE_KEYS - 1);
+
+			fill([=](std::size_t i) { return T(lo + (long long)(randomBelow(counterRandom(key, i), FEW_UNIQUE_KEYS)*step)); });
+			break;
+		}
+
+		case order::RANDOM:
+		default:
+			if constexpr (std::is_floating_point<T>::value)
+				fill([=](std::size_t i) { return T(double(lo) + double(counterRandom(key, i) >> 11)*0x1.0p-53*double(span - 1)); });
+			else
+				fill([=](std::size_t i) { return T(lo + (long long)randomBelow(counterRandom(key, i), span)); });
+			break;
+	}
+}
+
+/*************************************************************************
+ * Disorders m generated keys: mostly ordered swaps one random pair per 20
+ * keys (about 82-85% stay in place), k inversions swaps inversions (or
+ * sqrt(m)) random adjacent pairs.  Sequential and seeded, so repeatable.
+ *************************************************************************/
+template <typename T>
+void applyTestSwaps(T* a, std::size_t m, order type, uint64_t seed)
+{
+	const uint64_t key = splitmix64(seed ^ 0x5eed5eed5eed5eedULL);
+
+	if (type == order::MOSTLY_ORDERED && m)
+		for (std::size_t s = 0, swaps = std::max<std::size_t>(m/20, 1); s < swaps; s++)
+			std::swap(a[randomBelow(counterRandom(key, 2*s), m)], a[randomBelow(counterRandom(key, 2*s + 1), m)]);
+	else if (type == order::K_INVERSIONS && m > 1)
+	{
+		const std::size_t k = testDataConfig().inversions ? testDataConfig().inversions : std::size_t(std::sqrt(double(m)));
+
+		for (std::size_t s = 0; s < k; s++)
+		{
+			const std::size_t j = randomBelow(counterRandom(key, s), m - 1);
+
+			std::swap(a[j], a[j + 1]);
+		}
+	}
+}
+
+// Constructs a filled dynamic array of size n for benchmark test.
+template <typename T>
+T* constructTestArray(int n, order type)
+{
+	T* a = new T[n];
+
+	fillTestKeys(a, 0, n, n, type, testDataConfig().seed);
+	applyTestSwaps(a, n, type, testDataConfig().seed);
+
+	return a;
+}
 
 // Sort class with stl library sort algorithm set as default.
-template <typename T, typename void(*S)(T*, T*) = stlSort>
+template <typename T, void(*S)(T*, T*) = stlSort<T>>
 struct Sort 
 {
+	// True when S keeps equal elements in input order.
+	static constexpr bool stable = isStableSort<T, S>::value;
+
 	// This functor allows calling sort without benchmarking.
 	void operator() (T* start, T* last) { S(start, last); }
+
+	// Sorts a contiguous iterator range, e.g. of a std::vector<T>.
+	template <typename It>
+	void operator() (It first, It last)
+	{
+		if (first != last)
+			S(std::addressof(*first), std::addressof(*first) + (last - first));
+	}
 	
-	// Benchmark the sort.
-	void benchmark(int n, order type)  
+	// Benchmark the sort. Each trial sorts a fresh copy of the same input;
+	// copying and the sorted check are kept outside of the timed region.
+	BenchStats benchmark(int n, order type, const BenchConfig& cfg = BenchConfig())
 	{
+		BenchStats stats;
+
 		if (n) 
 		{
-			// Create a filled array of size n.
-			T* bmArray = constructTestArray(n, type);
+			// Create a filled array of size n, and a work copy for each trial.
+			std::unique_ptr<T[]> source(constructTestArray<T>(n, type));
+			std::unique_ptr<T[]> bmArray(new T[n]);
+
+			// Optionally place the work array's pages first (e.g. by NUMA node).
+			if (cfg.firstTouch)
+				cfg.firstTouch(bmArray.get(), n*sizeof(T));
+
+			stats = measure([&](PerfCounters* counters, PerfTotals* perf) {
+				return timedRun(
+					[&] { std::copy(source.get(), source.get() + n, bmArray.get()); },
+					[&] { S(bmArray.get(), bmArray.get() + n); },
+					[&] {
+						// Confirm the sort worked.
+						if (!std::is_sorted(bmArray.get(), bmArray.get() + n))
+							throw std::runtime_error("sort failed");
+					}, 
+					counters, perf);
+			}, cfg);
+
+			reportStats(stats, cfg, n);
+		}
 
-			if (bmArray)
-			{
-				// Time sort function and report the duration.
-				std::chrono::time_point<std::chrono::steady_clock> start= std::chrono::high_resolution_clock::now(); 
-				S(bmArray, bmArray + n);
-				std::chrono::duration<float> duration = std::chrono::high_resolution_clock::now() - start;
-				std::cout << "elapsed time: " << duration.count()*1000.0f << "ms" << std::endl;
-
-				// Confirm the sort worked.
-				if (!std::is_sorted(bmArray, bmArray + n))
-				{
-					delete[] bmArray;
-					throw std::runtime_error("sort failed");
-				}
+		return stats;
+	}
+};
+
+/*************************************************************************
+ * C++ STL <algorithm> library sort function. sort() uses an introsort
+ * (quicksort which switches to heapsort when the recursion reaches a
+ * certain depth).
+*************************************************************************/
+template<typename T, typename Compare>
+void stlSort(T* begin, T* end, Compare comp) { std::sort(begin, end, comp); }
+
+template<typename T>
+void stlSort(T* begin, T* end) { std::sort(begin, end); }
+
+/*************************************************************************
+ * C++ STL <algorithm> library heap sort function.
+*************************************************************************/
+template<typename T, typename Compare>
+void heapSort(T* begin, T* end, Compare comp)
+{
+	std::make_heap(begin, end, comp);
+	std::sort_heap(begin, end, comp);
+}
+
+template<typename T>
+void heapSort(T* begin, T* end) { heapSort(begin, end, std::less<T>()); }
+
+/*************************************************************************
+ * Implements the insertion sort algorithm.
+ *************************************************************************/
+template<class T, typename Compare>
+void insertionSort(T* begin, T* end, Compare comp)
+{
+	for (auto i = begin; i != end; i++)
+	{
+		for (auto j = i; j != begin; j--)
+		{
+			if (comp(*j, *(j - 1)))
+				std::swap(*j, *(j - 1));
+			else
+				break;
+		}
+	}
+}
+
+template<class T>
+void insertionSort(T* begin, T* end) { insertionSort(begin, end, std::less<T>()); }
+
+/*************************************************************************
+ * Implements a comb sort algorithm.
+ *************************************************************************/
+template <typename T, typename Compare>
+void combSort(T* begin, T* end, Compare comp)
+{
+	T *current, *next;
+	int length = static_cast<int>(std::distance(begin, end)), space = length;
+
+	for (bool swapped = false; (space > 1) || swapped;)
+	{
+		space = ((space*10) + 3)/13;
 
-				delete[] bmArray;
+		if ((space == 9) || (space == 10))
+			space = 11;
+
+		current = next = begin;
+		next += space;
+
+		for (swapped = false; next != end; current++, next++)
+			if (comp(*next, *current))
+			{
+				std::swap(*current, *next);
+				swapped = true;
 			}
+	}
+}
+
+template <typename T>
+void combSort(T* begin, T* end) { combSort(begin, end, std::less<T>()); }
+
+/*************************************************************************
+ * Implements a counting sort algorithm.
+ *************************************************************************/
+constexpr std::size_t COUNTING_MAX_RANGE = std::size_t(1) << 24; // Most buckets counted (all threads).
+
+// Number of buckets (max - min + 1) counting sort of n keys in [min, max] 
+// would use, or 0 if the range is too wide to beat radix sort: more than
+// 2n buckets (at least 4096), or more than COUNTING_MAX_RANGE. Differences
+// are taken unsigned, so any integral key type works without overflow.
+template<typename T>
+std::size_t countingBuckets(T min, T max, std::size_t n)
+{
+	typedef typename std::make_unsigned<T>::type U;
+	const U span = U(U(max) - U(min));
+	const std::size_t limit = std::min(COUNTING_MAX_RANGE, std::max<std::size_t>(2*n, 4096));
+
+	return (span < limit) ? std::size_t(span) + 1 : 0;
+}
+
+// Counts [begin, end) into count[0, buckets) (zeroed by the caller), where
+// bucket b holds key min + b, and writes the keys back in order.
+template<typename T>
+void countingSort(T* begin, T* end, T min, std::size_t buckets, std::size_t* count)
+{
+	typedef typename std::make_unsigned<T>::type U;
+
+	for (T* i = begin; i != end; ++i)
+		++count[U(U(*i) - U(min))];
+
+	T* start = begin;
+
+	for (std::size_t b = 0; b < buckets; ++b)
+	{
+		std::fill(start, start + count[b], T(U(min) + U(b)));
+		start += count[b];
+	}
+}
+
+// Smallest and largest key of a non-empty range.
+template<typename T>
+std::pair<T, T> keyRange(T* begin, T* end)
+{
+#if (__cpp_lib_parallel_algorithm >= 201603)
+	// Use parallel algorithm.
+	T min = *std::min_element(std::execution::par_unseq, begin, end);
+	T max = *std::max_element(std::execution::par_unseq, begin, end);
+#else
+	// Use standard algorithm.
+	T min = *std::min_element(begin, end);
+	T max = *std::max_element(begin, end);
+#endif
+	return std::make_pair(min, max);
+}
+
+// Keys spanning too wide a range for counting sort are radix sorted.
+template<typename T>
+void countingSort(T* begin, T* end)
+{
+	if (std::size_t(std::distance(begin, end)) <= TINY_SORT_MAX)
+	{
+		tinySort(begin, end, std::less<T>());
+		return;
+	}
+
+	const std::pair<T, T> range = keyRange(begin, end);
+	const std::size_t buckets = countingBuckets(range.first, range.second, std::distance(begin, end));
+
+	if (!buckets)
+	{
+		radixSort(begin, end);
+		return;
+	}
+
+	std::vector<std::size_t> count(buckets, 0);
+
+	countingSort(begin, end, range.first, buckets, count.data());
+}
+
+// Counting sort with the count table placed in a caller-owned arena.
+template<typename T>
+void countingSort(T* begin, T* end, ScratchArena& arena)
+{
+	if (std::size_t(std::distance(begin, end)) <= TINY_SORT_MAX)
+	{
+		tinySort(begin, end, std::less<T>());
+		return;
+	}
+
+	const std::pair<T, T> range = keyRange(begin, end);
+	const std::size_t buckets = countingBuckets(range.first, range.second, std::distance(begin, end));
+
+	if (!buckets)
+	{
+		radixSort(begin, end, arena);
+		return;
+	}
+
+	std::size_t* count = arena.get<std::size_t>(buckets);
+
+	std::fill(count, count + buckets, 0);
+	countingSort(begin, end, range.first, buckets, count);
+}
+
+// Counting sort policy using the calling thread's scratch arena.
+template<typename T>
+void countingSortArena(T* begin, T* end) { countingSort(begin, end, threadArena()); }
+
+/*************************************************************************
+ * Implements a pattern-defeating quicksort (after Orson Peters' pdqsort):
+ * median of 3 or ninther pivots, block partitioning without branches for
+ * arithmetic keys, sorting networks (arithmetic keys) or insertion sort
+ * of small partitions, detection of sorted input, and a heapsort fallback
+ * after log2(n) badly unbalanced partitions, bounding the worst case to 
+ * O(n log n).
+ *************************************************************************/
+constexpr std::ptrdiff_t QUICK_INSERTION = 24;   // Insertion sort partitions smaller than this.
+constexpr std::ptrdiff_t QUICK_NETWORK = 32;     // Network sort partitions up to this size (cheap compares).
+constexpr std::ptrdiff_t QUICK_NINTHER = 128;    // Ninther pivot above this size.
+constexpr std::ptrdiff_t QUICK_PARTIAL_MOVES = 8; // Moves before a partial insertion sort gives up.
+constexpr int QUICK_BLOCK = 64;                  // Block partition offset buffer size.
+
+// Insertion sort of [begin, end). Unguarded assumes *(begin - 1) is not
+// greater than any key in the range, so the inner loop has no bound check.
+template<class T, typename Compare>
+void quickInsertion(T* begin, T* end, bool unguarded, Compare comp)
+{
+	if (begin == end)
+		return;
+
+	for (T* i = begin + 1; i != end; ++i)
+	{
+		if (comp(*i, *(i - 1)))
+		{
+			T tmp = std::move(*i);
+			T* j = i;
+
+			do
+			{
+				*j = std::move(*(j - 1));
+				--j;
+			} while ((unguarded || j != begin) && comp(tmp, *(j - 1)));
+
+			*j = std::move(tmp);
+		}
+	}
+}
+
+// Insertion sort which gives up after a few moves. Returns true if the 
+// range is sorted.
+template<class T, typename Compare>
+bool quickPartialInsertion(T* begin, T* end, Compare comp)
+{
+	if (begin == end)
+		return true;
+
+	std::ptrdiff_t moves = 0;
+
+	for (T* i = begin + 1; i != end; ++i)
+	{
+		if (comp(*i, *(i - 1)))
+		{
+			T tmp = std::move(*i);
+			T* j = i;
+
+			do
+			{
+				*j = std::move(*(j - 1));
+				--j;
+			} while (j != begin && comp(tmp, *(j - 1)));
+
+			*j = std::move(tmp);
+			moves += i - j;
 		}
+
+		if (moves > QUICK_PARTIAL_MOVES)
+			return false;
+	}
+
+	return true;
+}
+
+// Orders *a <= *b <= *c.
+template<class T, typename Compare>
+inline void quickSort3(T* a, T* b, T* c, Compare comp)
+{
+	if (comp(*b, *a)) std::iter_swap(a, b);
+	if (comp(*c, *b)) std::iter_swap(b, c);
+	if (comp(*b, *a)) std::iter_swap(a, b);
+}
+
+// Moves the pivot *begin between the keys less than it and the keys not 
+// less than it, with Hoare style swaps. Returns the pivot position and 
+// whether the range was already partitioned (no swaps were needed).
+template<class T, typename Compare>
+std::pair<T*, bool> quickPartitionRight(T* begin, T* end, Compare comp)
+{
+	T pivot = std::move(*begin);
+	T* first = begin;
+	T* last = end;
+
+	// The median of 3 guarantees a key not less than the pivot on the 
+	// right, so the first scan needs no bound check.
+	while (comp(*++first, pivot));
+
+	if (first - 1 == begin)
+		while (first < last && !comp(*--last, pivot));
+	else
+		while (!comp(*--last, pivot));
+
+	const bool alreadyPartitioned = first >= last;
+
+	while (first < last)
+	{
+		std::iter_swap(first, last);
+		while (comp(*++first, pivot));
+		while (!comp(*--last, pivot));
 	}
 
-private:
-	// Constructs a filled dynamic array of size n for benchmark test.
-	T* constructTestArray(int n, order type)
+	T* pivotPos = first - 1;
+	*begin = std::move(*pivotPos);
+	*pivotPos = std::move(pivot);
+
+	return std::make_pair(pivotPos, alreadyPartitioned);
+}
+
+// Swaps num keys at left + offsetsL[i] with keys at right - offsetsR[i]. 
+// Uses a cyclic permutation (one move per key) unless the counts matched.
+template<class T>
+inline void quickSwapOffsets(T* left, T* right, const unsigned char* offsetsL, const unsigned char* offsetsR, std::size_t num, bool useSwaps)
+{
+	if (useSwaps)
+	{
+		for (std::size_t i = 0; i < num; ++i)
+			std::iter_swap(left + offsetsL[i], right - offsetsR[i]);
+	}
+	else if (num > 0)
 	{
-		T* a = new T[n];
+		T* l = left + offsetsL[0];
+		T* r = right - offsetsR[0];
+		T tmp = std::move(*l);
 
-		// Select order of array elements.
-		switch (type)
+		*l = std::move(*r);
+
+		for (std::size_t i = 1; i < num; ++i)
 		{
-			case order::ORDERED:
+			l = left + offsetsL[i];
+			*r = std::move(*l);
+			r = right - offsetsR[i];
+			*l = std::move(*r);
+		}
+
+		*r = std::move(tmp);
+	}
+}
+
+// Same result as quickPartitionRight, using block partitioning (Edelkamp 
+// and Weiss): comparisons of a block record misplaced key offsets without 
+// branching, then the misplaced keys are swapped in bulk.
+template<class T, typename Compare>
+std::pair<T*, bool> quickPartitionBlock(T* begin, T* end, Compare comp)
+{
+	T pivot = std::move(*begin);
+	T* first = begin;
+	T* last = end;
+
+	while (comp(*++first, pivot));
+
+	if (first - 1 == begin)
+		while (first < last && !comp(*--last, pivot));
+	else
+		while (!comp(*--last, pivot));
+
+	const bool alreadyPartitioned = first >= last;
+
+	if (!alreadyPartitioned)
+	{
+		std::iter_swap(first, last);
+		++first;
+
+		alignas(64) unsigned char offsetsL[QUICK_BLOCK];
+		alignas(64) unsigned char offsetsR[QUICK_BLOCK];
+		T* baseL = first;
+		T* baseR = last;
+		std::size_t numL = 0, numR = 0, startL = 0, startR = 0;
+
+		while (first < last)
+		{
+			// Fill whichever offset buffers are empty from the unknown keys.
+			const std::size_t unknown = last - first;
+			const std::size_t splitL = numL == 0 ? (numR == 0 ? unknown/2 : unknown) : 0;
+			const std::size_t splitR = numR == 0 ? (unknown - splitL) : 0;
+
+			for (std::size_t i = 0; i < std::min<std::size_t>(splitL, QUICK_BLOCK); i++)
 			{
-				// Sequentialize.  // std::iota(a, a+n, 1);
-				std::generate(a, a + n, [i = 1]() mutable { return i++; });
+				offsetsL[numL] = static_cast<unsigned char>(i);
+				numL += !comp(*first, pivot);
+				++first;
+			}
 
-				break;
+			for (std::size_t i = 0; i < std::min<std::size_t>(splitR, QUICK_BLOCK);)
+			{
+				offsetsR[numR] = static_cast<unsigned char>(++i);
+				numR += comp(*--last, pivot);
 			}
 
-			case order::REVERSED:
+			const std::size_t num = std::min(numL, numR);
+
+			quickSwapOffsets(baseL, baseR, offsetsL + startL, offsetsR + startR, num, numL == numR);
+			numL -= num;
+			numR -= num;
+			startL += num;
+			startR += num;
+
+			if (numL == 0)
 			{
-				// Sequentialize in reverse.
-				std::generate(a, a + n, [i = n]() mutable { return i--; });
-				//std::generate(a, a + n, [i = 1]() mutable { return i++; });
-				//std::reverse(a, a + n);
+				startL = 0;
+				baseL = first;
+			}
 
-				break;
+			if (numR == 0)
+			{
+				startR = 0;
+				baseR = last;
 			}
+		}
+
+		// Move the keys still recorded on one side next to the boundary.
+		if (numL)
+		{
+			while (numL--)
+				std::iter_swap(baseL + offsetsL[startL + numL], --last);
+			first = last;
+		}
 
-			case order::MOSTLY_ORDERED:
+		if (numR)
+		{
+			while (numR--)
+				std::iter_swap(baseR - offsetsR[startR + numR], first), ++first;
+			last = first;
+		}
+	}
+
+	T* pivotPos = first - 1;
+	*begin = std::move(*pivotPos);
+	*pivotPos = std::move(pivot);
+
+	return std::make_pair(pivotPos, alreadyPartitioned);
+}
+
+// Moves the keys equal to the pivot *begin to the left, in front of the 
+// larger keys, and returns the last equal key. Used when the pivot equals 
+// the key before the range, so every key in the range is not less than it.
+template<class T, typename Compare>
+T* quickPartitionLeft(T* begin, T* end, Compare comp)
+{
+	T pivot = std::move(*begin);
+	T* first = begin;
+	T* last = end;
+
+	while (comp(pivot, *--last));
+
+	if (last + 1 == end)
+		while (first < last && !comp(pivot, *++first));
+	else
+		while (!comp(pivot, *++first));
+
+	while (first < last)
+	{
+		std::iter_swap(first, last);
+		while (comp(pivot, *--last));
+		while (!comp(pivot, *++first));
+	}
+
+	T* pivotPos = last;
+	*begin = std::move(*pivotPos);
+	*pivotPos = std::move(pivot);
+
+	return pivotPos;
+}
+
+// Sorts [begin, end). The larger side of each partition is looped on and 
+// the smaller side recursed into, so the stack depth is O(log n). Leftmost 
+// is false when *(begin - 1) is a pivot not greater than every key.
+template<class T, typename Compare>
+void quick_sort(T* begin, T* end, int badAllowed, bool leftmost, Compare comp)
+{
+	for (;;)
+	{
+		const std::ptrdiff_t size = end - begin;
+
+		// Small partitions of cheaply compared keys go to a sorting network.
+		if constexpr (cheapCompare<T, Compare>::value)
+			if (size <= QUICK_NETWORK)
 			{
-				// Sequential.
-				std::generate(a, a + n, [i = 1]() mutable { return i++; });
+				tinySort(begin, end, comp);
+				return;
+			}
 
-				// Ordered percent will actually be about 82-85%.
-				const std::size_t percent = 80;
+		if (size < QUICK_INSERTION)
+		{
+			quickInsertion(begin, end, !leftmost, comp);
+			return;
+		}
 
-				// Random number distribution [0, n] [inclusive, inclusive].
-				std::uniform_int_distribution<T> dist(0, n);
-				std::random_device rd;
-				// Non-deterministic 32-bit seed.
-				std::mt19937 mt(rd());
+		// Pivot to *begin, with sentinels for the partition scans.
+		const std::ptrdiff_t half = size/2;
 
-				// Apply some order to array.
-				for (std::size_t i = 0, s = n, end = ((s < (100 - percent)) ? 1 : (s / (100 - percent))); i < end; i++)
-				{
-					std::size_t j = dist(mt);
-					std::size_t k = dist(mt);
-					std::swap(a[j], a[k]);
-				}
+		if (size > QUICK_NINTHER)
+		{
+			quickSort3(begin, begin + half, end - 1, comp);
+			quickSort3(begin + 1, begin + (half - 1), end - 2, comp);
+			quickSort3(begin + 2, begin + (half + 1), end - 3, comp);
+			quickSort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+			std::iter_swap(begin, begin + half);
+		}
+		else
+			quickSort3(begin + half, begin, end - 1, comp);
 
-				break;
+		// A pivot equal to the previous pivot means many duplicates; they 
+		// are all in place once moved left.
+		if (!leftmost && !comp(*(begin - 1), *begin))
+		{
+			begin = quickPartitionLeft(begin, end, comp) + 1;
+			continue;
+		}
+
+		const std::pair<T*, bool> part = cheapCompare<T, Compare>::value ? quickPartitionBlock(begin, end, comp) : quickPartitionRight(begin, end, comp);
+		T* pivotPos = part.first;
+		const std::ptrdiff_t sizeL = pivotPos - begin;
+		const std::ptrdiff_t sizeR = end - (pivotPos + 1);
+
+		if (sizeL < size/8 || sizeR < size/8)
+		{
+			// Too many bad pivots; heapsort guarantees O(n log n).
+			if (--badAllowed == 0)
+			{
+				heapSort(begin, end, comp);
+				return;
 			}
 
-			case order::RANDOM:
-			default:
+			// Break up patterns which produce bad pivots.
+			if (sizeL >= QUICK_INSERTION)
 			{
-				// Random number distribution [0, n] [inclusive, inclusive].
-				std::uniform_int_distribution<T> dist(0, n);
-				std::random_device rd;
-				// Non-deterministic 32-bit seed.
-				std::mt19937 mt(rd());
+				std::iter_swap(begin, begin + sizeL/4);
+				std::iter_swap(pivotPos - 1, pivotPos - sizeL/4);
+
+				if (sizeL > QUICK_NINTHER)
+				{
+					std::iter_swap(begin + 1, begin + (sizeL/4 + 1));
+					std::iter_swap(begin + 2, begin + (sizeL/4 + 2));
+					std::iter_swap(pivotPos - 2, pivotPos - (sizeL/4 + 1));
+					std::iter_swap(pivotPos - 3, pivotPos - (sizeL/4 + 2));
+				}
+			}
 
-				// Fill with random numbers.
-				std::generate(a, a + n, [&]() { return dist(mt); });
+			if (sizeR >= QUICK_INSERTION)
+			{
+				std::iter_swap(pivotPos + 1, pivotPos + (1 + sizeR/4));
+				std::iter_swap(end - 1, end - sizeR/4);
 
-				break;
+				if (sizeR > QUICK_NINTHER)
+				{
+					std::iter_swap(pivotPos + 2, pivotPos + (2 + sizeR/4));
+					std::iter_swap(pivotPos + 3, pivotPos + (3 + sizeR/4));
+					std::iter_swap(end - 2, end - (1 + sizeR/4));
+					std::iter_swap(end - 3, end - (2 + sizeR/4));
+				}
 			}
 		}
+		else if (part.second && quickPartialInsertion(begin, pivotPos, comp) && quickPartialInsertion(pivotPos + 1, end, comp))
+			// Partition needed no swaps and both sides were (nearly) sorted.
+			return;
 
-		return a;
+		if (sizeL < sizeR)
+		{
+			quick_sort(begin, pivotPos, badAllowed, leftmost, comp);
+			begin = pivotPos + 1;
+			leftmost = false;
+		}
+		else
+		{
+			quick_sort(pivotPos + 1, end, badAllowed, false, comp);
+			end = pivotPos;
+		}
 	}
-};
-
-/*************************************************************************
- * C++ STL <algorithm> library sort function. sort() uses an introsort
- * (quicksort which switches to heapsort when the recursion reaches a
- * certain depth).
-*************************************************************************/
-template<typename T>
-static void stlSort(T* begin, T* end) { std::sort(begin, end); }
+}
 
-/*************************************************************************
- * C++ STL <algorithm> library heap sort function.
-*************************************************************************/
-template<typename T>
-static void heapSort(T* begin, T* end)
+template<class T, typename Compare>
+void quickSort(T* begin, T* end, Compare comp)
 {
-	std::make_heap(begin, end);
-	std::sort_heap(begin, end);
+	const std::ptrdiff_t n = std::distance(begin, end);
+
+	if (n < 2)
+		return;
+
+	// Input that is one ascending or descending run needs a single pass.
+	T* run = begin + 1;
+
+	if (comp(*run, *begin))
+	{
+		while (run != end && !comp(*(run - 1), *run))
+			++run;
+
+		if (run == end)
+		{
+			std::reverse(begin, end);
+			return;
+		}
+	}
+	else
+	{
+		while (run != end && !comp(*run, *(run - 1)))
+			++run;
+
+		if (run == end)
+			return;
+	}
+
+	int badAllowed = 0;
+
+	for (std::ptrdiff_t m = n; m > 1; m >>= 1)
+		badAllowed++;
+
+	quick_sort(begin, end, badAllowed, true, comp);
 }
 
+template<class T>
+void quickSort(T* begin, T* end) { quickSort(begin, end, std::less<T>()); }
+
 /*************************************************************************
- * Implements the insertion sort algorithm.
+ * Implements a stable, run-adaptive merge sort (powersort): natural 
+ * ascending or strictly descending runs, short runs extended by binary 
+ * insertion sort, galloping merges, and the powersort merge policy of 
+ * Munro and Wild, which merges runs in a nearly optimal order. Input 
+ * made of k runs sorts in O(n log k); sorted input in a single pass.
  *************************************************************************/
-template<class T>
-static void insertionSort(T* begin, T* end)
+constexpr std::ptrdiff_t POWER_MIN_RUN = 24; // Shorter runs are extended to this length.
+constexpr std::ptrdiff_t POWER_GALLOP = 7;   // Consecutive wins that start galloping.
+
+// First key of the sorted range [begin, end) greater than key, found by 
+// exponential search from the front then binary search.
+template<class T, typename Compare>
+T* gallopUpper(T* begin, T* end, const T& key, Compare comp)
 {
-	for (auto i = begin; i != end; i++)
+	const std::ptrdiff_t n = end - begin;
+	std::ptrdiff_t hi = 1;
+
+	while (hi <= n && !comp(key, begin[hi - 1]))
+		hi *= 2;
+
+	return std::upper_bound(begin + hi/2, begin + std::min(hi, n), key, comp);
+}
+
+// First key of the sorted range [begin, end) not less than key, found by 
+// exponential search from the front then binary search.
+template<class T, typename Compare>
+T* gallopLower(T* begin, T* end, const T& key, Compare comp)
+{
+	const std::ptrdiff_t n = end - begin;
+	std::ptrdiff_t hi = 1;
+
+	while (hi <= n && comp(begin[hi - 1], key))
+		hi *= 2;
+
+	return std::lower_bound(begin + hi/2, begin + std::min(hi, n), key, comp);
+}
+
+// As gallopUpper, searching from the back.
+template<class T, typename Compare>
+T* gallopUpperBack(T* begin, T* end, const T& key, Compare comp)
+{
+	const std::ptrdiff_t n = end - begin;
+	std::ptrdiff_t hi = 1;
+
+	while (hi <= n && comp(key, end[-hi]))
+		hi *= 2;
+
+	return std::upper_bound(end - std::min(hi, n), end - hi/2, key, comp);
+}
+
+// As gallopLower, searching from the back.
+template<class T, typename Compare>
+T* gallopLowerBack(T* begin, T* end, const T& key, Compare comp)
+{
+	const std::ptrdiff_t n = end - begin;
+	std::ptrdiff_t hi = 1;
+
+	while (hi <= n && !comp(end[-hi], key))
+		hi *= 2;
+
+	return std::lower_bound(end - std::min(hi, n), end - hi/2, key, comp);
+}
+
+// Stable merge of the sorted runs [lo, mid) and [mid, hi). The shorter 
+// run is moved to buffer, which holds at least (hi - lo)/2 keys. After 
+// POWER_GALLOP consecutive wins by one run, blocks are found by galloping 
+// and moved at once, until the blocks get short again.
+template<class T, typename Compare>
+void powerMerge(T* lo, T* mid, T* hi, T* buffer, Compare comp)
+{
+	// Keys already in their final place at either end need not move.
+	lo = gallopUpper(lo, mid, *mid, comp);
+
+	if (lo == mid)
+		return;
+
+	hi = gallopLowerBack(mid, hi, *(mid - 1), comp);
+
+	if (mid - lo <= hi - mid)
+	{
+		// Merge forward from the left run in buffer.
+		T* a = buffer, *aEnd = std::move(lo, mid, buffer);
+		T* b = mid, *dest = lo;
+
+		while (a != aEnd && b != hi)
+		{
+			std::ptrdiff_t winsA = 0, winsB = 0;
+
+			while (a != aEnd && b != hi && winsA < POWER_GALLOP && winsB < POWER_GALLOP)
+			{
+				if (comp(*b, *a))
+				{
+					*dest++ = std::move(*b++);
+					winsB++;
+					winsA = 0;
+				}
+				else
+				{
+					*dest++ = std::move(*a++);
+					winsA++;
+					winsB = 0;
+				}
+			}
+
+			while (a != aEnd && b != hi)
+			{
+				T* stopA = gallopUpper(a, aEnd, *b, comp);
+				const std::ptrdiff_t countA = stopA - a;
+				dest = std::move(a, stopA, dest);
+				a = stopA;
+
+				if (a == aEnd)
+					break;
+
+				T* stopB = gallopLower(b, hi, *a, comp);
+				const std::ptrdiff_t countB = stopB - b;
+				dest = std::move(b, stopB, dest);
+				b = stopB;
+
+				if (countA < POWER_GALLOP && countB < POWER_GALLOP)
+					break;
+			}
+		}
+
+		// Any rest of the right run is already in place.
+		std::move(a, aEnd, dest);
+	}
+	else
 	{
-		for (auto j = i; j != begin; j--)
+		// Merge backward from the right run in buffer.
+		T* b = buffer, *bEnd = std::move(mid, hi, buffer);
+		T* a = mid, *dest = hi;
+
+		while (a != lo && b != bEnd)
 		{
-			if (*j < *(j - 1))
-				std::swap(*j, *(j - 1));
-			else
-				break;
+			std::ptrdiff_t winsA = 0, winsB = 0;
+
+			while (a != lo && b != bEnd && winsA < POWER_GALLOP && winsB < POWER_GALLOP)
+			{
+				if (comp(*(bEnd - 1), *(a - 1)))
+				{
+					*--dest = std::move(*--a);
+					winsA++;
+					winsB = 0;
+				}
+				else
+				{
+					*--dest = std::move(*--bEnd);
+					winsB++;
+					winsA = 0;
+				}
+			}
+
+			while (a != lo && b != bEnd)
+			{
+				T* stopA = gallopUpperBack(lo, a, *(bEnd - 1), comp);
+				const std::ptrdiff_t countA = a - stopA;
+				dest = std::move_backward(stopA, a, dest);
+				a = stopA;
+
+				if (a == lo)
+					break;
+
+				T* stopB = gallopLowerBack(b, bEnd, *(a - 1), comp);
+				const std::ptrdiff_t countB = bEnd - stopB;
+				dest = std::move_backward(stopB, bEnd, dest);
+				bEnd = stopB;
+
+				if (countA < POWER_GALLOP && countB < POWER_GALLOP)
+					break;
+			}
 		}
+
+		// Any rest of the left run is already in place.
+		std::move_backward(b, bEnd, dest);
 	}
 }
 
-/*************************************************************************
- * Implements a comb sort algorithm.
- *************************************************************************/
-template <typename T>
-static void combSort(T* begin, T* end)
+// End of the run starting at begin, extended to at least POWER_MIN_RUN 
+// keys. A strictly descending run is reversed, keeping equal keys in order.
+template<class T, typename Compare>
+T* powerRun(T* begin, T* end, Compare comp)
 {
-	T *current, *next;
-	int length = static_cast<int>(std::distance(begin, end)), space = length;
+	T* run = begin + 1;
 
-	for (bool swapped = false; (space > 1) || swapped;)
+	if (run == end)
+		return end;
+
+	if (comp(*run, *begin))
 	{
-		space = ((space*10) + 3)/13;
+		while (run != end && comp(*run, *(run - 1)))
+			++run;
 
-		if ((space == 9) || (space == 10))
-			space = 11;
+		std::reverse(begin, run);
+	}
+	else
+		while (run != end && !comp(*run, *(run - 1)))
+			++run;
 
-		current = next = begin;
-		next += space;
+	// Binary insertion sort of the keys up to the minimum run length.
+	T* stop = (end - begin > POWER_MIN_RUN) ? begin + POWER_MIN_RUN : end;
 
-		for (swapped = false; next != end; current++, next++)
-			if (*next < *current)
-			{
-				std::swap(*current, *next);
-				swapped = true;
-			}
+	for (; run < stop; ++run)
+	{
+		T key = std::move(*run);
+		T* pos = std::upper_bound(begin, run, key, comp);
+
+		std::move_backward(pos, run, run + 1);
+		*pos = std::move(key);
 	}
+
+	return run;
 }
 
-/*************************************************************************
- * Implements a counting sort algorithm.
- *************************************************************************/
-template<typename T>
-void countingSort(T* begin, T* end)
+// Powersort node power of the boundary between runs [begin, mid) and 
+// [mid, end) in an array of n keys: the first bit in which the run 
+// midpoints, as binary fractions of n, differ.
+inline int powerOf(std::size_t begin, std::size_t mid, std::size_t end, std::size_t n)
 {
-#if (__cpp_lib_parallel_algorithm >= 201603)
-	// Use parallel algorithm.
-	T min = *std::min_element(std::execution::par_unseq, begin, end);
-	T max = *std::max_element(std::execution::par_unseq, begin, end);
-#else
-	// Use standard algorithm.
-	T min = *std::min_element(begin, end);
-	T max = *std::max_element(begin, end);
-#endif
-	std::vector<unsigned> count((max - min) + 1, 0);
+	std::size_t a = begin + mid, b = mid + end; // Twice the midpoints.
+	const std::size_t n2 = 2*n;
+	int power = 0;
 
-	for (T* i = begin; i != end; ++i)
-		++count[*i - min];
+	for (;;)
+	{
+		power++;
+		a *= 2;
+		b *= 2;
 
-	T* start = begin;
+		if ((a >= n2) != (b >= n2))
+			return power;
 
-	for (T i = min; i <= max; ++i)
-		for (unsigned j = 0; j < count[i - min]; ++j)
-			*start++ = i;
+		if (a >= n2)
+		{
+			a -= n2;
+			b -= n2;
+		}
+	}
 }
 
-/*************************************************************************
- * Implements a basic quick sort algorithm.
- *************************************************************************/
-template<class T>
-void quick_sort(T* begin, int first, int last)
+template<class T, typename Compare>
+void powerSort(T* begin, T* end, T* buffer, Compare comp)
 {
-	int lower = first + 1, upper = last;
+	const std::size_t n = std::distance(begin, end);
+
+	if (n < 2)
+		return;
 
-	//std::swap(*(begin + first), *(begin + (first + last)/2));
-	T bound = *(begin + first);
+	// Pending runs, each with the power of the boundary after it. Powers
+	// strictly increase up the stack, so it never exceeds the word size.
+	struct Run { T* begin; T* end; int power; };
+	Run stack[8*sizeof(std::size_t) + 2];
+	int top = 0;
+	Run a{ begin, powerRun(begin, end, comp), 0 };
 
-	while (lower <= upper)
+	while (a.end != end)
 	{
-		while (*(begin + lower) < bound)
-			lower++;
+		Run b{ a.end, powerRun(a.end, end, comp), 0 };
+		const int power = powerOf(a.begin - begin, a.end - begin, b.end - begin, n);
 
-		while (bound < *(begin + upper))
-			upper--;
-
-		if (lower < upper)
+		// Merge pending runs whose boundary is deeper in the merge tree.
+		while (top && stack[top - 1].power > power)
 		{
-			std::swap(*(begin + lower), *(begin + upper));
-			upper--;
+			powerMerge(stack[top - 1].begin, a.begin, a.end, buffer, comp);
+			a.begin = stack[--top].begin;
 		}
 
-		lower++;
+		a.power = power;
+		stack[top++] = a;
+		a = b;
 	}
 
-	std::swap(*(begin + upper), *(begin + first));
-
-	if (first < upper - 1)
-		quick_sort(begin, first, upper - 1);
-
-	if (upper + 1 < last)
-		quick_sort(begin, upper + 1, last);
+	while (top)
+	{
+		powerMerge(stack[top - 1].begin, a.begin, a.end, buffer, comp);
+		a.begin = stack[--top].begin;
+	}
 }
 
 template<class T>
-void quickSort(T* begin, T* end)
-{
-	const int n = static_cast<int>(std::distance(begin, end));
-
-	if (n < 2)
-		return;
-
-	int max = 0;
+void powerSort(T* begin, T* end, T* buffer) { powerSort(begin, end, buffer, std::less<T>()); }
 
-	// Find largest element and put it at the end.
-	for (int i = 1; i < n; i++)
-		if (*(begin + max) < *(begin + i))
-			max = i;
+template<class T, typename Compare>
+void powerSort(T* begin, T* end, Compare comp)
+{
+	std::unique_ptr<T[]> buffer(new T[std::distance(begin, end)/2 + 1]);
 
-	// Largest element is now in its final position.
-	std::swap(*(begin + n - 1), *(begin + max));
-	quick_sort(begin, 0, n - 2);
+	powerSort(begin, end, buffer.get(), comp);
 }
 
-#if (_MSC_VER && __cpp_lib_parallel_algorithm < 201603)
-/*************************************************************************
- Concurrent MSVC++ Parallel Patterns Library radix sort.
- *************************************************************************/
-template <typename T>
-void pRadix(T* begin, T* end) { Concurrency::parallel_radixsort(begin, end); }
+template<class T>
+void powerSort(T* begin, T* end) { powerSort(begin, end, std::less<T>()); }
 
+#if (_MSC_VER && __cpp_lib_parallel_algorithm < 201603)
 /*************************************************************************
  * Implements a concurrent MSVC++ Parallel Patterns Library quicksort.
  *************************************************************************/
@@ -382,6 +1331,49 @@ template <typename T>
 void pSort(T* begin, T* end) { std::sort(std::execution::par_unseq, begin, end); }
 #endif
 
+/*************************************************************************
+ * Order-preserving radix key transform.
+ *************************************************************************/
+// Unsigned integer type of the same width as key type T.
+template <typename T, bool = std::is_floating_point<T>::value>
+struct radixBits { typedef typename std::make_unsigned<T>::type type; };
+
+template <typename T>
+struct radixBits<T, true> 
+{
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8, "radix sort supports 32 and 64-bit floating point");
+	typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type type; 
+};
+
+// Maps a key to an unsigned integer whose unsigned order matches the 
+// key order. Signed integers have their sign bit flipped. IEEE-754 
+// values have all bits flipped if negative, otherwise the sign bit set 
+// (total order: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN).
+template <typename T>
+inline typename radixBits<T>::type radixKey(T v)
+{
+	typedef typename radixBits<T>::type U;
+	constexpr U SIGN_BIT = U(1) << (8*sizeof(U) - 1);
+	U u;
+
+	memcpy(&u, &v, sizeof(u));
+
+	if (std::is_floating_point<T>::value)
+		return (u & SIGN_BIT) ? U(~u) : U(u | SIGN_BIT);
+	else if (std::is_signed<T>::value)
+		return u ^ SIGN_BIT;
+	else
+		return u;
+}
+
+// Orders keys by radixKey, the order of the radix passes (for floating
+// point keys the IEEE total order, which places NaN and -0 too).
+struct RadixLess
+{
+	template <typename T>
+	bool operator() (T a, T b) const { return radixKey(a) < radixKey(b); }
+};
+
 /*************************************************************************
  * Implements a radix sort algorithm.
 *************************************************************************/
@@ -402,32 +1394,38 @@ void pSort(T* begin, T* end) { std::sort(std::execution::par_unseq, begin, end);
 //    to perform a scatter operation.  Instead the elements are left in 
 //    place and only copied if they need to be copied to the final output 
 //    buffer.
-
-template <typename T>
-void radixSort(T* begin, T* end)
+// Digits are taken from radixKey(), so signed and floating point keys 
+// sort correctly, and bucket counts are size_t so arrays may exceed 4G 
+// elements.  radixSortKeyed takes the digits from any key functor that 
+// maps an element to an unsigned integer (e.g. a field of a record, or a 
+// complemented key for descending order); the functor is inlined, so 
+// radixSort itself pays nothing for it.
+
+template <typename T, typename Key>
+void radixSortKeyed(T* begin, T* end, T* buffer, Key key)
 {
-	T* temp, *first = begin;
-	T* buffer = new T[std::distance(begin, end)], *pBuffer = buffer;
+	typedef decltype(key(*begin)) U;
+	T* temp, *first = begin, *pBuffer = buffer;
 	constexpr int DIGIT_BITS = 8;                   // Bits per digit.
 	constexpr size_t NUM_BUCKETS = 1 << DIGIT_BITS; // Number of buckets.
-	constexpr T BUCKET_MASK = NUM_BUCKETS - 1;      // Mask all bits.
-	uint32_t bucketSize[NUM_BUCKETS];
-	uint32_t bucketPos[NUM_BUCKETS];
+	constexpr size_t BUCKET_MASK = NUM_BUCKETS - 1; // Mask all bits.
+	size_t bucketSize[NUM_BUCKETS];
+	size_t bucketPos[NUM_BUCKETS];
 	bool doSeparateHistogramCalculation = true;
 
-	for (uint32_t j = 0; j < (8 * sizeof(T)); j += DIGIT_BITS)
+	for (uint32_t j = 0; j < (8 * sizeof(U)); j += DIGIT_BITS)
 	{
 		if (doSeparateHistogramCalculation)
 		{
 			memset(bucketSize, 0, sizeof(bucketSize));
 			// Calculate histogram for the first scatter operation
 			for (temp = first; temp != end; ++temp)
-				++bucketSize[(*temp >> j) & BUCKET_MASK];
+				++bucketSize[(key(*temp) >> j) & BUCKET_MASK];
 		}
 
 		// If a single bucket contains all of the elements, then don't 
 		// bother redistributing all elements to the same bucket.
-		if (bucketSize[((*first >> j) & BUCKET_MASK)] == uint32_t(end - first))
+		if (bucketSize[((key(*first) >> j) & BUCKET_MASK)] == size_t(end - first))
 		{
 			// Set flag to ensure histogram is computed for next digit position.
 			doSeparateHistogramCalculation = true;
@@ -439,7 +1437,7 @@ void radixSort(T* begin, T* end)
 			doSeparateHistogramCalculation = false;
 
 			// If this is the last digit position, then don't calculate a histogram
-			if (j == (8 * sizeof(T) - DIGIT_BITS))
+			if (j == (8 * sizeof(U) - DIGIT_BITS))
 			{
 				bucketPos[0] = 0;
 
@@ -448,7 +1446,7 @@ void radixSort(T* begin, T* end)
 
 				for (temp = first; temp != end; ++temp)
 				{
-					const size_t digit = (*temp >> j) & BUCKET_MASK;
+					const size_t digit = (key(*temp) >> j) & BUCKET_MASK;
 					*(pBuffer + bucketPos[digit]++) = *temp;
 				}
 			}
@@ -466,9 +1464,9 @@ void radixSort(T* begin, T* end)
 
 				for (temp = first; temp != end; ++temp)
 				{
-					const size_t digit = (*temp >> j) & BUCKET_MASK;
+					const size_t digit = (key(*temp) >> j) & BUCKET_MASK;
 					*(pBuffer + bucketPos[digit]++) = *temp;
-					++bucketSize[(*temp >> next) & BUCKET_MASK];
+					++bucketSize[(key(*temp) >> next) & BUCKET_MASK];
 				}
 			}
 
@@ -483,8 +1481,394 @@ void radixSort(T* begin, T* end)
 	if (first != begin)
 		for (temp = first; temp != end; ++temp)
 			*pBuffer++ = *temp;
+}
+
+// Tiny arrays skip the passes (and the buffer) for a sorting network.
+template <typename T>
+void radixSort(T* begin, T* end, T* buffer) 
+{
+	if (std::size_t(std::distance(begin, end)) <= TINY_SORT_MAX)
+		tinySort(begin, end, RadixLess());
+	else
+		radixSortKeyed(begin, end, buffer, [](T x) { return radixKey(x); }); 
+}
+
+template <typename T>
+void radixSort(T* begin, T* end)
+{
+	if (std::size_t(std::distance(begin, end)) <= TINY_SORT_MAX)
+	{
+		tinySort(begin, end, RadixLess());
+		return;
+	}
+
+	std::unique_ptr<T[]> buffer(new T[std::distance(begin, end)]);
+
+	radixSort(begin, end, buffer.get());
+}
+
+// Radix sort with the buffer placed in a caller-owned arena.
+template <typename T>
+void radixSort(T* begin, T* end, ScratchArena& arena) { radixSort(begin, end, arena.get<T>(std::distance(begin, end))); }
+
+// Radix sort policy using the calling thread's scratch arena.
+template <typename T>
+void radixSortArena(T* begin, T* end) { radixSort(begin, end, threadArena()); }
+
+/*************************************************************************
+ * Runs f(t) for t in [0, threads), each on its own thread (t = 0 runs on
+ * the calling thread), and waits for all of them to finish.
+ *************************************************************************/
+template <typename F>
+void forEachThread(std::size_t threads, F f)
+{
+	std::vector<std::thread> pool;
+
+	pool.reserve(threads - 1);
+	for (std::size_t t = 1; t < threads; t++)
+		pool.emplace_back(f, t);
+
+	f(0);
+
+	for (std::thread& th : pool)
+		th.join();
+}
+
+/*************************************************************************
+ * Implements a multi-threaded LSD radix sort.
+ *************************************************************************/
+// Each digit pass runs in two parallel phases over equal, contiguous
+// chunks of the source, one per thread:
+// 1. Every thread builds a histogram of its own chunk.
+// 2. The per-thread histograms are merged by an exclusive prefix sum in
+//    (bucket, thread) order, which gives every thread a private output 
+//    range inside each bucket.  Threads then scatter their chunk into 
+//    those ranges without synchronization, and the sort stays stable.
+// As in radixSort, a pass whose digit is the same for all elements is 
+// skipped.  Small arrays are handed to the sequential radixSort.
+template <typename T>
+void pRadix(T* begin, T* end)
+{
+	constexpr int DIGIT_BITS = 8;                           // Bits per digit.
+	constexpr std::size_t NUM_BUCKETS = 1 << DIGIT_BITS;    // Number of buckets.
+	constexpr std::size_t BUCKET_MASK = NUM_BUCKETS - 1;    // Mask all bits.
+	constexpr std::size_t MIN_PER_THREAD = 1 << 16;         // Smallest chunk worth a thread.
+	typedef std::array<std::size_t, NUM_BUCKETS> Histogram;
+
+	const std::size_t n = std::distance(begin, end);
+	const std::size_t threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), n/MIN_PER_THREAD);
+
+	if (threads < 2)
+	{
+		radixSort(begin, end);
+		return;
+	}
+
+	std::unique_ptr<T[]> buffer(new T[n]);
+	std::vector<Histogram> count(threads);
+	T* src = begin, *dst = buffer.get();
+
+	for (uint32_t j = 0; j < (8 * sizeof(T)); j += DIGIT_BITS)
+	{
+		// Phase 1: per-thread histograms.
+		forEachThread(threads, [&](std::size_t t) {
+			Histogram& c = count[t];
+
+			c.fill(0);
+			for (T* p = src + n*t/threads, *last = src + n*(t + 1)/threads; p != last; ++p)
+				++c[(radixKey(*p) >> j) & BUCKET_MASK];
+		});
+
+		// Skip this digit if a single bucket holds all of the elements.
+		const std::size_t first = (radixKey(*src) >> j) & BUCKET_MASK;
+		std::size_t total = 0;
+
+		for (std::size_t t = 0; t < threads; t++)
+			total += count[t][first];
+
+		if (total == n)
+			continue;
+
+		// Merge: exclusive prefix sum in (bucket, thread) order.
+		for (std::size_t b = 0, pos = 0; b < NUM_BUCKETS; b++)
+			for (std::size_t t = 0; t < threads; t++)
+			{
+				const std::size_t c = count[t][b];
+				count[t][b] = pos;
+				pos += c;
+			}
+
+		// Phase 2: parallel scatter into per-thread bucket ranges.
+		forEachThread(threads, [&](std::size_t t) {
+			Histogram pos = count[t];
+
+			for (T* p = src + n*t/threads, *last = src + n*(t + 1)/threads; p != last; ++p)
+				dst[pos[(radixKey(*p) >> j) & BUCKET_MASK]++] = *p;
+		});
+
+		std::swap(src, dst);
+	}
+
+	// Copy buffer to original array.
+	if (src != begin)
+		forEachThread(threads, [&](std::size_t t) {
+			std::copy(src + n*t/threads, src + n*(t + 1)/threads, begin + n*t/threads);
+		});
+}
+
+/*************************************************************************
+ * Implements a multi-threaded counting sort.
+ *************************************************************************/
+// For integral keys of a small range (status codes, shard ids):
+// 1. Every thread finds the min and max of its own chunk.
+// 2. Every thread counts its chunk into its own histogram. For ranges up
+//    to COUNTING_LANES_RANGE keys, consecutive keys go to four interleaved
+//    tables, so runs of equal keys do not serialize on one counter.
+// 3. The histograms are summed (in parallel over bucket slices) and turned
+//    into bucket start positions by a prefix sum.
+// 4. Every thread writes an equal share of the output, as std::fill spans
+//    of the buckets overlapping its share, so skewed keys stay balanced.
+// Wider ranges (see countingBuckets) use pRadix. 
+// The thread count is reduced so all histograms fit COUNTING_MAX_RANGE.
+template <typename T>
+void pCounting(T* begin, T* end)
+{
+	constexpr std::size_t MIN_PER_THREAD = 1 << 16;               // Smallest chunk worth a thread.
+	constexpr std::size_t COUNTING_LANES_RANGE = 1 << 12;         // Ranges counted in interleaved tables.
+	static_assert(std::is_integral<T>::value, "counting sort requires integral keys");
+	typedef typename std::make_unsigned<T>::type U;
+
+	const std::size_t n = std::distance(begin, end);
+	std::size_t threads = std::max<std::size_t>(1, std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), n/MIN_PER_THREAD));
+
+	if (n < 2)
+		return;
+
+	// Phase 1: key range.
+	std::vector<std::pair<T, T>> ranges(threads);
+
+	forEachThread(threads, [&](std::size_t t) {
+		const auto mm = std::minmax_element(begin + n*t/threads, begin + n*(t + 1)/threads);
+		ranges[t] = std::make_pair(*mm.first, *mm.second);
+	});
+
+	T min = ranges[0].first, max = ranges[0].second;
+
+	for (const std::pair<T, T>& r : ranges)
+	{
+		min = std::min(min, r.first);
+		max = std::max(max, r.second);
+	}
+
+	const std::size_t buckets = countingBuckets(min, max, n);
+
+	if (!buckets)
+	{
+		pRadix(begin, end);
+		return;
+	}
+
+	threads = std::max<std::size_t>(1, std::min(threads, COUNTING_MAX_RANGE/buckets));
+
+	// Phase 2: per-thread histograms.
+	const std::size_t lanes = (buckets <= COUNTING_LANES_RANGE) ? 4 : 1;
+	const std::size_t stride = lanes*buckets;
+	std::unique_ptr<std::size_t[]> count(new std::size_t[threads*stride]);
+
+	forEachThread(threads, [&](std::size_t t) {
+		std::size_t* c = count.get() + t*stride;
+		T* p = begin + n*t/threads, *last = begin + n*(t + 1)/threads;
+
+		std::fill(c, c + stride, 0);
+
+		if (lanes == 4)
+		{
+			for (; last - p >= 4; p += 4)
+			{
+				++c[U(U(p[0]) - U(min))];
+				++c[buckets + U(U(p[1]) - U(min))];
+				++c[2*buckets + U(U(p[2]) - U(min))];
+				++c[3*buckets + U(U(p[3]) - U(min))];
+			}
+		}
+
+		for (; p != last; ++p)
+			++c[U(U(*p) - U(min))];
+	});
+
+	// Phase 3: bucket totals (in thread 0's first table), then start positions.
+	forEachThread(threads, [&](std::size_t t) {
+		for (std::size_t b = buckets*t/threads, last = buckets*(t + 1)/threads; b != last; ++b)
+		{
+			std::size_t total = 0;
+
+			for (std::size_t i = 0; i < threads*lanes; i++)
+				total += count[i*buckets + b];
+
+			count[b] = total;
+		}
+	});
+
+	std::vector<std::size_t> start(buckets + 1);
+
+	for (std::size_t b = 0; b < buckets; b++)
+		start[b + 1] = start[b] + count[b];
+
+	// Phase 4: parallel fill of each thread's share of the output.
+	forEachThread(threads, [&](std::size_t t) {
+		std::size_t pos = n*t/threads;
+		const std::size_t last = n*(t + 1)/threads;
+		std::size_t b = std::upper_bound(start.begin(), start.end(), pos) - start.begin() - 1;
+
+		for (; pos < last; b++)
+		{
+			const std::size_t stop = std::min(start[b + 1], last);
+
+			std::fill(begin + pos, begin + stop, T(U(min) + U(b)));
+			pos = stop;
+		}
+	});
+}
+
+/*************************************************************************
+ * Argsort and key-value sorting.
+ *************************************************************************/
+// The argsort functions write the stable sorting permutation of keys to 
+// perm (perm[i] is the index of the i-th smallest key) and leave the keys
+// untouched.  Only compact (key, index) pairs are moved while sorting; 
+// payloads are moved once, by applyPermutation, at the end.
+
+// Radix argsort: LSD radix sort of (radixKey, index) pairs.  All digit 
+// histograms are computed in the single pass that builds the pairs, and 
+// passes whose digit is the same for all keys are skipped.
+template <typename K, typename I>
+void radixArgsort(const K* keys, std::size_t n, I* perm)
+{
+	typedef typename radixBits<K>::type U;
+	struct Item { U key; I index; };
+	constexpr int DIGIT_BITS = 8;                           // Bits per digit.
+	constexpr std::size_t NUM_BUCKETS = 1 << DIGIT_BITS;    // Number of buckets.
+	constexpr std::size_t BUCKET_MASK = NUM_BUCKETS - 1;    // Mask all bits.
+	constexpr std::size_t PASSES = (8 * sizeof(U))/DIGIT_BITS;
+
+	if (n == 0)
+		return;
+
+	std::unique_ptr<Item[]> a(new Item[n]), b(new Item[n]);
+	std::vector<std::array<std::size_t, NUM_BUCKETS>> count(PASSES);
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const U key = radixKey(keys[i]);
+
+		a[i].key = key;
+		a[i].index = I(i);
+		for (std::size_t p = 0; p < PASSES; p++)
+			++count[p][(key >> (p * DIGIT_BITS)) & BUCKET_MASK];
+	}
+
+	Item* src = a.get(), *dst = b.get();
+
+	for (std::size_t p = 0; p < PASSES; p++)
+	{
+		const int j = int(p) * DIGIT_BITS;
+		std::array<std::size_t, NUM_BUCKETS>& pos = count[p];
+
+		// Skip this digit if a single bucket holds all of the elements.
+		if (pos[(src->key >> j) & BUCKET_MASK] == n)
+			continue;
+
+		for (std::size_t i = 0, sum = 0; i < NUM_BUCKETS; i++)
+		{
+			const std::size_t c = pos[i];
+			pos[i] = sum;
+			sum += c;
+		}
+
+		for (Item* it = src; it != src + n; ++it)
+			dst[pos[(it->key >> j) & BUCKET_MASK]++] = *it;
+
+		std::swap(src, dst);
+	}
+
+	for (std::size_t i = 0; i < n; i++)
+		perm[i] = src[i].index;
+}
+
+// STL argsort: std::sort of (key, index) pairs.  Ties are broken by index,
+// which makes the permutation stable.
+template <typename K, typename I>
+void stlArgsort(const K* keys, std::size_t n, I* perm)
+{
+	std::unique_ptr<std::pair<K, I>[]> a(new std::pair<K, I>[n]);
+
+	for (std::size_t i = 0; i < n; i++)
+		a[i] = std::make_pair(keys[i], I(i));
+
+	std::sort(a.get(), a.get() + n);
+
+	for (std::size_t i = 0; i < n; i++)
+		perm[i] = a[i].second;
+}
+
+// Parallel argsort: as stlArgsort, using the C++17 parallel sort when 
+// available.
+template <typename K, typename I>
+void pArgsort(const K* keys, std::size_t n, I* perm)
+{
+	std::unique_ptr<std::pair<K, I>[]> a(new std::pair<K, I>[n]);
+
+	for (std::size_t i = 0; i < n; i++)
+		a[i] = std::make_pair(keys[i], I(i));
+
+#if (__cpp_lib_parallel_algorithm >= 201603)
+	std::sort(std::execution::par_unseq, a.get(), a.get() + n);
+#else
+	std::sort(a.get(), a.get() + n);
+#endif
+
+	for (std::size_t i = 0; i < n; i++)
+		perm[i] = a[i].second;
+}
+
+// Reorders data so that data[i] becomes the old data[perm[i]].  Each 
+// element is gathered once into a buffer and copied back.
+template <typename T, typename I>
+void applyPermutation(T* data, const I* perm, std::size_t n)
+{
+	std::unique_ptr<T[]> buffer(new T[n]);
+
+	for (std::size_t i = 0; i < n; i++)
+		buffer[i] = data[perm[i]];
+
+	std::copy(buffer.get(), buffer.get() + n, data);
+}
+
+// Sorts parallel key and value arrays (struct of arrays) by key.
+template <typename K, typename V, void(*A)(const K*, std::size_t, uint32_t*) = radixArgsort<K>>
+void sortByKey(K* keys, V* values, std::size_t n)
+{
+	std::unique_ptr<uint32_t[]> perm(new uint32_t[n]);
+
+	A(keys, n, perm.get());
+	applyPermutation(keys, perm.get(), n);
+	applyPermutation(values, perm.get(), n);
+}
+
+// Sorts records by the key Key(record) returns.  Keys are extracted and
+// argsorted, then every record is moved once into its final position.
+template <typename R, typename K, K(*Key)(const R&), void(*A)(const K*, std::size_t, uint32_t*) = radixArgsort<K>>
+void sortRecords(R* begin, R* end)
+{
+	const std::size_t n = std::distance(begin, end);
+	std::unique_ptr<K[]> keys(new K[n]);
+	std::unique_ptr<uint32_t[]> perm(new uint32_t[n]);
+
+	for (std::size_t i = 0; i < n; i++)
+		keys[i] = Key(begin[i]);
 
-	delete[] buffer;
+	A(keys.get(), n, perm.get());
+	applyPermutation(begin, perm.get(), n);
 }
 #endif
 
@@ -0,0 +1,264 @@
+/*************************************************************************
+* Title: Stable Sorts.
+* File: stable_sort.h
+* Date: 10/16/2026
+*
+* Which sort policies are stable, and stable sorts that scale:
+*   compile-time stability of a (T*, T*) policy (isStableSort)
+*   STL stable sort, sequential and parallel (stlStableSort, pStableSort)
+*   parallel stable merge sort with a reusable buffer (parallelStableSort)
+*   stable parallel LSD radix sort by key (parallelRadixSortKeyed,
+*   parallelRadixSort)
+*
+* Notes:
+*  (1) A stable sort keeps elements that compare equal in input order, so
+*      sorting by a secondary key and then stably by the primary key
+*      orders by both.  Stable: insertionSort, powerSort, radixSort,
+*      countingSort (and their arena versions), radixSortWC, pRadix,
+*      pCounting, lcpMergeSort and the sorts here.  Not stable: stlSort,
+*      heapSort, combSort, quickSort, pSort, networkSort, simdSort,
+*      sampleSort, numaSort, autoSort and the other string sorts.
+*  (2) isStableSort<T, S>::value, also Sort<T, S>::stable, is true for the
+*      stable policies of note 1; a policy missing from stableSortPolicy
+*      counts as unstable.  Equal plain keys cannot be told apart, so the
+*      sorting network leaves of the radix and counting sorts do not
+*      matter; their keyed versions sort no leaves by network.
+*  (3) parallelStableSort sorts one run per pool thread (rounded up to a
+*      power of two) with powerSort, then merges the runs pairwise in
+*      log2(runs) rounds, ping-ponging between the array and the buffer.
+*      Each round is split among the threads at equal output positions by
+*      merge path (mergeCoRank), taking ties from the left run, so every
+*      thread is busy in every round and the merge stays stable.  The n
+*      element buffer comes from the caller or a scratch arena, so
+*      repeated sorts do not allocate.
+*  (4) parallelRadixSortKeyed sorts by 8-bit digits of key(x), least
+*      significant first: per part histograms, a prefix sum in (digit,
+*      part) order, and a scatter of each part into its own ranges, so
+*      equal digits keep input order.  A digit that is the same for every
+*      element is skipped.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _STABLE_SORT_H_
+#define _STABLE_SORT_H_
+
+constexpr std::size_t STABLE_PARALLEL_MIN{ std::size_t(1) << 15 }; // Smallest array sorted in parallel.
+constexpr std::size_t STABLE_PART_MIN{ std::size_t(1) << 14 };     // Smallest share of a merge or radix task.
+
+/*************************************************************************
+ * STL stable sort, sequential and C++17 parallel.
+ *************************************************************************/
+template <typename T>
+void stlStableSort(T* begin, T* end) { std::stable_sort(begin, end); }
+
+#if (__cpp_lib_parallel_algorithm >= 201603)
+template <typename T>
+void pStableSort(T* begin, T* end) { std::stable_sort(std::execution::par, begin, end); }
+#endif
+
+/*************************************************************************
+ * Stable parallel merge sort of [begin, end) on pool, using buffer (n
+ * elements) as scratch.
+ *************************************************************************/
+template <typename T, typename Compare>
+void parallelStableSort(T* begin, T* end, T* buffer, Compare comp, ThreadPool& pool)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if (n < STABLE_PARALLEL_MIN || pool.size() < 2)
+	{
+		powerSort(begin, end, buffer, comp);
+		return;
+	}
+
+	std::size_t runs = 1;
+
+	while (runs < pool.size())
+		runs *= 2;
+
+	const std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(pool.size(), n/STABLE_PART_MIN));
+	auto first = [n, runs](std::size_t r) { return n*r/runs; };
+
+	// Each run is sorted with its slice of the buffer as scratch.
+	pool.parallelFor(runs, [&](std::size_t r, unsigned w) {
+		powerSort(begin + first(r), begin + first(r + 1), buffer + first(r), comp);
+		pool.addWork(w, first(r + 1) - first(r));
+	});
+
+	T* src = begin, * dst = buffer;
+
+	// Round width w merges runs [r, r + w) and [r + w, r + 2w).
+	for (std::size_t width = 1; width < runs; width *= 2)
+	{
+		pool.parallelFor(parts, [&](std::size_t p, unsigned w) {
+			const std::size_t lo = n*p/parts, hi = n*(p + 1)/parts;
+
+			for (std::size_t r = 0; r < runs; r += 2*width)
+			{
+				const std::size_t aLo = first(r), bLo = first(r + width), bHi = first(r + 2*width);
+				const std::size_t x = std::max(lo, aLo), y = std::min(hi, bHi);
+
+				if (x >= y)
+					continue;
+
+				// This part's share of the merged run [aLo, bHi).
+				const T* A = src + aLo, *B = src + bLo;
+				const std::size_t m = bLo - aLo, l = bHi - bLo;
+				const std::size_t a0 = mergeCoRank(x - aLo, A, m, B, l, comp), a1 = mergeCoRank(y - aLo, A, m, B, l, comp);
+
+				std::merge(A + a0, A + a1, B + (x - aLo - a0), B + (y - aLo - a1), dst + x, comp);
+			}
+
+			pool.addWork(w, hi - lo);
+		});
+
+		std::swap(src, dst);
+	}
+
+	if (src != begin)
+		pool.parallelFor(parts, [&](std::size_t p, unsigned) {
+			std::copy(src + n*p/parts, src + n*(p + 1)/parts, begin + n*p/parts);
+		});
+}
+
+// Buffer from a scratch arena (T trivially copyable).
+template <typename T, typename Compare>
+void parallelStableSort(T* begin, T* end, Compare comp, ScratchArena& arena, ThreadPool& pool)
+{
+	parallelStableSort(begin, end, arena.get<T>(std::distance(begin, end)), comp, pool);
+}
+
+template <typename T, typename Compare>
+void parallelStableSort(T* begin, T* end, Compare comp)
+{
+	if constexpr (std::is_trivially_copyable<T>::value)
+		parallelStableSort(begin, end, comp, threadArena(), sortPool());
+	else
+	{
+		std::unique_ptr<T[]> buffer(new T[std::distance(begin, end)]);
+
+		parallelStableSort(begin, end, buffer.get(), comp, sortPool());
+	}
+}
+
+template <typename T>
+void parallelStableSort(T* begin, T* end) { parallelStableSort(begin, end, std::less<T>()); }
+
+/*************************************************************************
+ * Stable parallel LSD radix sort of [begin, end) by the unsigned key(x)
+ * on pool, using buffer (n elements) as scratch.
+ *************************************************************************/
+template <typename T, typename Key>
+void parallelRadixSortKeyed(T* begin, T* end, T* buffer, Key key, ThreadPool& pool)
+{
+	typedef typename std::decay<decltype(key(*begin))>::type U;
+	constexpr std::size_t BUCKETS{ 256 };
+	const std::size_t n = std::distance(begin, end);
+	const std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(pool.size(), n/STABLE_PART_MIN));
+
+	if (parts < 2)
+	{
+		radixSortKeyed(begin, end, buffer, key);
+		return;
+	}
+
+	std::vector<std::array<std::size_t, BUCKETS>> count(parts);
+	T* src = begin, * dst = buffer;
+
+	for (unsigned shift = 0; shift < 8*sizeof(U); shift += 8)
+	{
+		pool.parallelFor(parts, [&](std::size_t p, unsigned) {
+			count[p].fill(0);
+
+			for (const T* x = src + n*p/parts; x != src + n*(p + 1)/parts; ++x)
+				count[p][(key(*x) >> shift) & 0xff]++;
+		});
+
+		// Skip a digit every element shares.
+		const std::size_t digit = (key(*src) >> shift) & 0xff;
+		std::size_t same = 0;
+
+		for (std::size_t p = 0; p < parts; p++)
+			same += count[p][digit];
+
+		if (same == n)
+			continue;
+
+		// Part p's range of each digit follows those of the earlier parts.
+		std::size_t sum = 0;
+
+		for (std::size_t d = 0; d < BUCKETS; d++)
+			for (std::size_t p = 0; p < parts; p++)
+			{
+				const std::size_t c = count[p][d];
+
+				count[p][d] = sum;
+				sum += c;
+			}
+
+		pool.parallelFor(parts, [&](std::size_t p, unsigned w) {
+			std::array<std::size_t, BUCKETS>& next = count[p];
+
+			for (const T* x = src + n*p/parts; x != src + n*(p + 1)/parts; ++x)
+				dst[next[(key(*x) >> shift) & 0xff]++] = *x;
+
+			pool.addWork(w, n*(p + 1)/parts - n*p/parts);
+		});
+
+		std::swap(src, dst);
+	}
+
+	if (src != begin)
+		pool.parallelFor(parts, [&](std::size_t p, unsigned) {
+			std::copy(src + n*p/parts, src + n*(p + 1)/parts, begin + n*p/parts);
+		});
+}
+
+template <typename T, typename Key>
+void parallelRadixSortKeyed(T* begin, T* end, Key key)
+{
+	parallelRadixSortKeyed(begin, end, threadArena().get<T>(std::distance(begin, end)), key, sortPool());
+}
+
+// Sort policy: parallelRadixSortKeyed of arithmetic keys by radixKey.
+template <typename T>
+void parallelRadixSort(T* begin, T* end)
+{
+	parallelRadixSortKeyed(begin, end, [](const T& x) { return radixKey(x); });
+}
+
+/*************************************************************************
+ * Stability of the (T*, T*) sort policies.
+ *************************************************************************/
+template <typename T>
+constexpr bool stableSortPolicy(void (*sort)(T*, T*))
+{
+	typedef void (*Policy)(T*, T*);
+	auto is = [sort](Policy p) { return sort == p; };
+
+	if constexpr (std::is_same<T, std::string>::value)
+		if (is(lcpMergeSort))
+			return true;
+
+	if constexpr (std::is_arithmetic<T>::value)
+		if (is(radixSort<T>) || is(radixSortArena<T>) || is(radixSortWC<T>) || is(pRadix<T>) || is(parallelRadixSort<T>))
+			return true;
+
+	if constexpr (std::is_integral<T>::value)
+		if (is(countingSort<T>) || is(countingSortArena<T>) || is(pCounting<T>))
+			return true;
+
+#if (__cpp_lib_parallel_algorithm >= 201603)
+	if (is(pStableSort<T>))
+		return true;
+#endif
+
+	return is(insertionSort<T>) || is(powerSort<T>) || is(stlStableSort<T>) || is(parallelStableSort<T>);
+}
+
+// True when the policy S keeps equal elements in input order.
+template <typename T, void (*S)(T*, T*)>
+struct isStableSort : std::integral_constant<bool, stableSortPolicy<T>(S)> { };
+
+#endif
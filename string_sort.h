@@ -0,0 +1,629 @@
+/*************************************************************************
+* Title: String Sorts.
+* File: string_sort.h
+* Date: 10/16/2026
+*
+* Sorts of variable-length string keys, on arrays of keys referencing
+* the caller's characters (StringKey) or on std::string arrays:
+*   MSD radix sort (msdRadixSort)
+*   multikey quicksort (multikeyQuickSort)
+*   LCP-aware stable merge sort (lcpMergeSort)
+*   radix sort of cached 8 character prefixes (prefixRadixSort)
+*   generated URL, identifier, word, random and long prefix test strings
+*
+* Notes:
+*  (1) Strings are ordered as std::string orders them: by unsigned
+*      characters, a proper prefix first.  Characters may include '\0'.
+*  (2) A StringKey holds a string's characters pointer, size, and its
+*      index in the caller's array.  The std::string kernels sort keys,
+*      then move the strings into sorted order through a second array, so
+*      strings are moved twice and never copied.
+*  (3) msdRadixSort distributes by the character at the current depth
+*      into 257 buckets (one for strings that have ended), caching each
+*      key's character in a side array so every level reads the strings
+*      once.  Characters that all keys share are skipped in one pass,
+*      comparing a word at a time.  Buckets below STRING_RADIX_MIN keys go to
+*      multikeyQuickSort (Bentley and Sedgewick), a three-way quicksort on
+*      one character at a time, which finishes below STRING_INSERTION_MAX
+*      keys with insertion sort.
+*  (4) lcpMergeSort (Ng and Kakehi) carries the longest common prefix of
+*      each key with its predecessor.  Merging compares the two heads'
+*      LCPs with the last output first, and only compares characters when
+*      they are equal, starting after the shared prefix; each character
+*      is then inspected O(1) times per merge level.  It is stable.
+*  (5) prefixRadixSort is an MSD radix sort that stores 8 characters of
+*      every key as a big-endian integer beside it (PrefixKey), and reads
+*      each level's character from there.  The strings are read once per
+*      8 levels instead of once per level, or to skip characters that all
+*      keys share.  Groups below PREFIX_RADIX_MIN
+*      keys are sorted by comparing prefixes first.
+*  (6) Test strings are a function of (seed, value), where the value comes
+*      from the numeric generator of the order.  Orders other than random,
+*      Zipf and few unique map value v to the v-th smallest generated
+*      string, so ordered input is sorted and reversed input reversed.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _STRING_SORT_H_
+#define _STRING_SORT_H_
+
+constexpr std::size_t STRING_INSERTION_MAX{ 16 }; // Largest array sorted by insertion sort.
+constexpr std::size_t STRING_RADIX_MIN{ 64 };     // Smallest bucket distributed by msdRadixSort.
+constexpr std::size_t PREFIX_RADIX_MIN{ 256 };    // Smallest group radix sorted by prefixRadixSort.
+
+// String key: characters owned by the caller, and the string's index in
+// the caller's array.
+struct StringKey
+{
+	const char* data;
+	std::size_t size;
+	std::size_t index;
+};
+
+// Key with the 8 characters from the current depth cached as an integer.
+struct PrefixKey
+{
+	uint64_t prefix;
+	StringKey key;
+};
+
+// Character d of s as 1..256, or 0 past its end.
+inline unsigned stringChar(const StringKey& s, std::size_t d) { return (d < s.size) ? unsigned((unsigned char)s.data[d]) + 1 : 0; }
+
+// Length of the common prefix of a and b, whose first d characters are
+// known to be equal.
+inline std::size_t commonPrefix(const StringKey& a, const StringKey& b, std::size_t d)
+{
+	const std::size_t m = std::min(a.size, b.size);
+
+	for (; d + 8 <= m; d += 8)
+	{
+		uint64_t x, y;
+
+		std::memcpy(&x, a.data + d, 8);
+		std::memcpy(&y, b.data + d, 8);
+		if (x != y)
+			break;
+	}
+
+	while (d < m && a.data[d] == b.data[d])
+		d++;
+
+	return d;
+}
+
+// Compares a and b, equal in their first d characters: negative, zero or
+// positive.  Their common prefix length is stored in lcp.
+inline int compareStrings(const StringKey& a, const StringKey& b, std::size_t d, std::size_t& lcp)
+{
+	lcp = commonPrefix(a, b, d);
+
+	if (lcp == std::min(a.size, b.size))
+		return (a.size > b.size) - (a.size < b.size);
+
+	return int((unsigned char)a.data[lcp]) - int((unsigned char)b.data[lcp]);
+}
+
+inline bool stringLess(const StringKey& a, const StringKey& b, std::size_t d = 0)
+{
+	std::size_t lcp;
+
+	return compareStrings(a, b, d, lcp) < 0;
+}
+
+// Insertion sort of keys whose first depth characters are equal.
+inline void stringInsertionSort(StringKey* begin, StringKey* end, std::size_t depth)
+{
+	for (StringKey* i = begin + (begin != end); i < end; ++i)
+	{
+		const StringKey x = *i;
+		StringKey* j = i;
+
+		for (; j != begin && stringLess(x, j[-1], depth); --j)
+			*j = j[-1];
+
+		*j = x;
+	}
+}
+
+/*************************************************************************
+ * Multikey quicksort of keys whose first depth characters are equal.
+ *************************************************************************/
+inline void multikeyQuickSort(StringKey* begin, StringKey* end, std::size_t depth)
+{
+	for (;;)
+	{
+		const std::size_t n = std::distance(begin, end);
+
+		if (n <= STRING_INSERTION_MAX)
+		{
+			stringInsertionSort(begin, end, depth);
+			return;
+		}
+
+		// Median of three characters as pivot.
+		const unsigned a = stringChar(begin[0], depth), b = stringChar(begin[n/2], depth), c = stringChar(end[-1], depth);
+		const unsigned pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+		// Three-way partition: [begin, lt) < pivot, [lt, gt) equal, [gt, end) >.
+		StringKey* lt = begin, * i = begin, * gt = end;
+
+		while (i < gt)
+		{
+			const unsigned ch = stringChar(*i, depth);
+
+			if (ch < pivot)
+				std::swap(*lt++, *i++);
+			else if (ch > pivot)
+				std::swap(*i, *--gt);
+			else
+				++i;
+		}
+
+		multikeyQuickSort(begin, lt, depth);
+		multikeyQuickSort(gt, end, depth);
+
+		// Keys equal to the pivot continue one character deeper, unless
+		// they have all ended.
+		if (!pivot)
+			return;
+
+		begin = lt;
+		end = gt;
+		depth++;
+	}
+}
+
+inline void multikeyQuickSort(StringKey* begin, StringKey* end) { multikeyQuickSort(begin, end, 0); }
+
+/*************************************************************************
+ * MSD radix sort of keys whose first depth characters are equal, using
+ * buffer and chars (one per key) as scratch.
+ *************************************************************************/
+inline void msdRadixSort(StringKey* begin, StringKey* end, StringKey* buffer, uint16_t* chars, std::size_t depth)
+{
+	constexpr std::size_t BUCKETS = 257;
+	const std::size_t n = std::distance(begin, end);
+
+	if (n < STRING_RADIX_MIN)
+	{
+		multikeyQuickSort(begin, end, depth);
+		return;
+	}
+
+	std::size_t count[BUCKETS];
+
+	// Skip depths at which every key has the same character.
+	for (;;)
+	{
+		std::fill(count, count + BUCKETS, std::size_t(0));
+
+		for (std::size_t i = 0; i < n; i++)
+			count[chars[i] = uint16_t(stringChar(begin[i], depth))]++;
+
+		if (count[chars[0]] != n)
+			break;
+		if (!chars[0])
+			return;
+
+		// Jump over every character the keys share, a word at a time.
+		std::size_t shared = begin[0].size;
+
+		for (std::size_t i = 1; i < n && shared > depth + 1; i++)
+			shared = std::min(shared, commonPrefix(begin[0], begin[i], depth + 1));
+
+		depth = shared;
+	}
+
+	std::size_t start[BUCKETS], next[BUCKETS];
+
+	start[0] = 0;
+	for (std::size_t b = 1; b < BUCKETS; b++)
+		start[b] = start[b - 1] + count[b - 1];
+	std::copy(start, start + BUCKETS, next);
+
+	for (std::size_t i = 0; i < n; i++)
+		buffer[next[chars[i]]++] = begin[i];
+	std::copy(buffer, buffer + n, begin);
+
+	// Bucket 0 holds ended, equal strings; the others continue deeper.
+	for (std::size_t b = 1; b < BUCKETS; b++)
+		if (count[b] > 1)
+			msdRadixSort(begin + start[b], begin + start[b] + count[b], buffer, chars, depth + 1);
+}
+
+inline void msdRadixSort(StringKey* begin, StringKey* end)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if (n < STRING_RADIX_MIN)
+	{
+		multikeyQuickSort(begin, end, 0);
+		return;
+	}
+
+	std::unique_ptr<StringKey[]> buffer(new StringKey[n]);
+	std::unique_ptr<uint16_t[]> chars(new uint16_t[n]);
+
+	msdRadixSort(begin, end, buffer.get(), chars.get(), 0);
+}
+
+/*************************************************************************
+ * Stable merge of the sorted keys a[0, na) and b[0, nb) into out, with
+ * the LCP arrays of each (lcp[i] of a key with its predecessor).
+ *************************************************************************/
+inline void lcpMerge(const StringKey* a, const std::size_t* aLcp, std::size_t na, const StringKey* b, const std::size_t* bLcp,
+	std::size_t nb, StringKey* out, std::size_t* outLcp)
+{
+	// ha and hb are the LCPs of the heads with the last key output.
+	std::size_t i = 0, j = 0, ha = 0, hb = 0;
+
+	while (i < na && j < nb)
+	{
+		std::size_t h = 0;
+
+		if (ha > hb || (ha == hb && compareStrings(a[i], b[j], ha, h) <= 0))
+		{
+			// a[i] precedes b[j], which shares h (or hb) characters with it.
+			*out++ = a[i];
+			*outLcp++ = ha;
+			hb = (ha > hb) ? hb : h;
+			if (++i < na)
+				ha = aLcp[i];
+		}
+		else
+		{
+			*out++ = b[j];
+			*outLcp++ = hb;
+			ha = (hb > ha) ? ha : h;
+			if (++j < nb)
+				hb = bLcp[j];
+		}
+	}
+
+	while (i < na)
+	{
+		*out++ = a[i];
+		*outLcp++ = ha;
+		if (++i < na)
+			ha = aLcp[i];
+	}
+
+	while (j < nb)
+	{
+		*out++ = b[j];
+		*outLcp++ = hb;
+		if (++j < nb)
+			hb = bLcp[j];
+	}
+}
+
+// Sorts keys s[0, n) with their LCP array lcp into t (if into) or in
+// place, the other array serving as scratch.
+inline void lcpMergeSort(StringKey* s, std::size_t* lcp, std::size_t n, StringKey* t, std::size_t* tLcp, bool into)
+{
+	if (n <= STRING_INSERTION_MAX)
+	{
+		stringInsertionSort(s, s + n, 0);
+
+		lcp[0] = 0;
+		for (std::size_t i = 1; i < n; i++)
+			lcp[i] = commonPrefix(s[i - 1], s[i], 0);
+
+		if (into)
+		{
+			std::copy(s, s + n, t);
+			std::copy(lcp, lcp + n, tLcp);
+		}
+		return;
+	}
+
+	// The halves are sorted into the array the merge reads from.
+	const std::size_t half = n/2;
+
+	lcpMergeSort(s, lcp, half, t, tLcp, !into);
+	lcpMergeSort(s + half, lcp + half, n - half, t + half, tLcp + half, !into);
+
+	if (into)
+		lcpMerge(s, lcp, half, s + half, lcp + half, n - half, t, tLcp);
+	else
+		lcpMerge(t, tLcp, half, t + half, tLcp + half, n - half, s, lcp);
+}
+
+inline void lcpMergeSort(StringKey* begin, StringKey* end)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if (!n)
+		return;
+
+	std::unique_ptr<StringKey[]> buffer(new StringKey[n]);
+	std::unique_ptr<std::size_t[]> lcp(new std::size_t[n]), bufferLcp(new std::size_t[n]);
+
+	lcpMergeSort(begin, lcp.get(), n, buffer.get(), bufferLcp.get(), false);
+}
+
+// Characters [d, d + 8) of s as a big-endian integer, zero padded.
+inline uint64_t stringPrefix(const StringKey& s, std::size_t d)
+{
+	uint64_t prefix = 0;
+
+	for (std::size_t k = d; k < d + 8; k++)
+		prefix = (prefix << 8) | ((k < s.size) ? uint64_t((unsigned char)s.data[k]) : 0);
+
+	return prefix;
+}
+
+/*************************************************************************
+ * MSD radix sort of keys whose first depth characters are equal, reading
+ * the characters from prefixes cached from depth base, using buffer as
+ * scratch.
+ *************************************************************************/
+inline void prefixRadixSort(PrefixKey* begin, PrefixKey* end, PrefixKey* buffer, std::size_t depth, std::size_t base)
+{
+	constexpr std::size_t BUCKETS = 256;
+	const std::size_t n = std::distance(begin, end);
+
+	if (n < PREFIX_RADIX_MIN)
+	{
+		std::sort(begin, end, [depth](const PrefixKey& a, const PrefixKey& b) {
+			return (a.prefix != b.prefix) ? a.prefix < b.prefix : stringLess(a.key, b.key, depth);
+		});
+		return;
+	}
+
+	std::size_t count[BUCKETS];
+	unsigned shift;
+
+	// Skip the characters every key shares, reloading the prefixes once
+	// past the 8 cached ones.
+	for (;;)
+	{
+		if (depth >= base + 8)
+		{
+			base = depth;
+			for (PrefixKey* p = begin; p != end; ++p)
+				p->prefix = stringPrefix(p->key, depth);
+		}
+
+		shift = unsigned(56 - 8*(depth - base));
+		std::fill(count, count + BUCKETS, std::size_t(0));
+		for (PrefixKey* p = begin; p != end; ++p)
+			count[(p->prefix >> shift) & 0xff]++;
+
+		const std::size_t first = (begin->prefix >> shift) & 0xff;
+
+		if (count[first] != n || !first)
+			break;
+
+		std::size_t shared = begin->key.size;
+
+		for (PrefixKey* p = begin + 1; p != end && shared > depth + 1; ++p)
+			shared = std::min(shared, commonPrefix(begin->key, p->key, depth + 1));
+
+		depth = shared;
+	}
+
+	std::size_t next[BUCKETS];
+
+	next[0] = 0;
+	for (std::size_t b = 1; b < BUCKETS; b++)
+		next[b] = next[b - 1] + count[b - 1];
+
+	for (PrefixKey* p = begin; p != end; ++p)
+		buffer[next[(p->prefix >> shift) & 0xff]++] = *p;
+	std::copy(buffer, buffer + n, begin);
+
+	// Bucket 0 holds the strings that have ended, which are equal and go
+	// first, and those with a '\0' character here.
+	PrefixKey* bucket = begin;
+
+	if (count[0] > 1)
+	{
+		PrefixKey* nulls = std::partition(begin, begin + count[0], [depth](const PrefixKey& p) { return p.key.size <= depth; });
+
+		prefixRadixSort(nulls, begin + count[0], buffer, depth + 1, base);
+	}
+
+	for (std::size_t b = 0; b < BUCKETS; bucket += count[b++])
+		if (b && count[b] > 1)
+			prefixRadixSort(bucket, bucket + count[b], buffer, depth + 1, base);
+}
+
+inline void prefixRadixSort(StringKey* begin, StringKey* end)
+{
+	const std::size_t n = std::distance(begin, end);
+	std::unique_ptr<PrefixKey[]> keys(new PrefixKey[n]), buffer(new PrefixKey[n]);
+
+	for (std::size_t i = 0; i < n; i++)
+		keys[i] = PrefixKey{ stringPrefix(begin[i], 0), begin[i] };
+
+	prefixRadixSort(keys.get(), keys.get() + n, buffer.get(), 0, 0);
+
+	for (std::size_t i = 0; i < n; i++)
+		begin[i] = keys[i].key;
+}
+
+/*************************************************************************
+ * Sorts std::strings with a StringKey kernel, then moves them into their
+ * sorted places.
+ *************************************************************************/
+template <typename F>
+void sortStrings(std::string* begin, std::string* end, F sortKeys)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if (n < 2)
+		return;
+
+	std::unique_ptr<StringKey[]> keys(new StringKey[n]);
+
+	for (std::size_t i = 0; i < n; i++)
+		keys[i] = StringKey{ begin[i].data(), begin[i].size(), i };
+
+	sortKeys(keys.get(), keys.get() + n);
+
+	// keys[i].index is the string that belongs at i.  Gathering them in
+	// order and moving them back writes sequentially, unlike following
+	// the permutation's cycles in place.
+	std::unique_ptr<std::string[]> sorted(new std::string[n]);
+
+	for (std::size_t i = 0; i < n; i++)
+		sorted[i] = std::move(begin[keys[i].index]);
+
+	std::move(sorted.get(), sorted.get() + n, begin);
+}
+
+inline void msdRadixSort(std::string* begin, std::string* end) { sortStrings(begin, end, [](StringKey* b, StringKey* e) { msdRadixSort(b, e); }); }
+inline void multikeyQuickSort(std::string* begin, std::string* end) { sortStrings(begin, end, [](StringKey* b, StringKey* e) { multikeyQuickSort(b, e); }); }
+inline void lcpMergeSort(std::string* begin, std::string* end) { sortStrings(begin, end, [](StringKey* b, StringKey* e) { lcpMergeSort(b, e); }); }
+inline void prefixRadixSort(std::string* begin, std::string* end) { sortStrings(begin, end, [](StringKey* b, StringKey* e) { prefixRadixSort(b, e); }); }
+
+/*************************************************************************
+ * Generated test strings.
+ *************************************************************************/
+enum StringShape { STRING_URL, STRING_IDENT, STRING_WORDS, STRING_RANDOM, STRING_PREFIX };
+
+inline const char* stringShapeName(StringShape shape)
+{
+	switch (shape)
+	{
+		case STRING_IDENT:  return "ident";
+		case STRING_WORDS:  return "words";
+		case STRING_RANDOM: return "random";
+		case STRING_PREFIX: return "prefix";
+		case STRING_URL:
+		default:            return "url";
+	}
+}
+
+// Shape of generated std::string test data.
+inline StringShape& testStringShape()
+{
+	static StringShape shape = STRING_URL;
+
+	return shape;
+}
+
+constexpr std::size_t STRING_HOSTS{ 1000 };       // Distinct URL hosts.
+constexpr std::size_t STRING_VOCABULARY{ 4096 };  // Distinct words of URL paths and identifiers.
+constexpr std::size_t STRING_PREFIX_LENGTH{ 64 }; // Shared prefix of prefix strings.
+
+// Word of 1 to 4 syllables, a function of r.
+inline void appendTestWord(std::string& s, uint64_t r, bool capital = false)
+{
+	static const char* const syllables[] = { "ka", "lo", "mi", "ne", "ru", "sa", "ti", "po", "ver", "dan",
+		"bel", "cor", "fin", "gur", "hol", "ster" };
+	const std::size_t length = 1 + (r & 3);
+
+	for (std::size_t k = 0; k < length; k++)
+	{
+		const char* syllable = syllables[(r >> (2 + 4*k)) & 15];
+
+		s += (capital && !k) ? char(std::toupper((unsigned char)syllable[0])) : syllable[0];
+		s += syllable + 1;
+	}
+}
+
+// Test string number v of the given shape and stream key.
+inline std::string testString(StringShape shape, uint64_t v, uint64_t key)
+{
+	const uint64_t r = counterRandom(key, v);
+	std::string s;
+
+	switch (shape)
+	{
+		case STRING_IDENT:
+		{
+			// e.g. getHolKaSter_17: a verb, 1-3 capitalized words, a suffix.
+			static const char* const verbs[] = { "get", "set", "is", "on", "make", "parse", "to", "find" };
+
+			s = verbs[r & 7];
+			for (uint64_t k = 0, words = 1 + randomBelow(r, 3); k < words; k++)
+				appendTestWord(s, splitmix64(randomBelow(counterRandom(r, k), STRING_VOCABULARY)), true);
+			if (r & 8)
+				s += '_' + std::to_string((r >> 4) & 255);
+			break;
+		}
+
+		case STRING_WORDS:
+			appendTestWord(s, r);
+			break;
+
+		case STRING_RANDOM:
+		{
+			static const char alphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+			const std::size_t length = 8 + randomBelow(r, 25);
+
+			for (std::size_t k = 0; k < length; k++)
+				s += alphabet[randomBelow(counterRandom(r, k), sizeof(alphabet) - 1)];
+			break;
+		}
+
+		case STRING_PREFIX:
+			s.assign(STRING_PREFIX_LENGTH, 'x');
+			for (std::size_t k = 0; k < 8; k++)
+				s += char('a' + randomBelow(counterRandom(r, k), 26));
+			break;
+
+		case STRING_URL:
+		default:
+		{
+			// e.g. https://www.bellomi.com/kane/corsti/48213: a host of a
+			// few hundred, 1-4 path words, sometimes a numeric id.
+			static const char* const domains[] = { ".com/", ".org/", ".net/", ".io/" };
+			const uint64_t host = splitmix64(randomBelow(r, STRING_HOSTS));
+
+			s = "https://www.";
+			appendTestWord(s, host);
+			s += domains[host >> 62];
+			for (uint64_t k = 0, words = 1 + randomBelow(r, 4); k < words; k++)
+			{
+				if (k)
+					s += '/';
+				appendTestWord(s, splitmix64(randomBelow(counterRandom(r, k), STRING_VOCABULARY)));
+			}
+			if (r & 1)
+				s += '/' + std::to_string((r >> 8) % 100000);
+			break;
+		}
+	}
+
+	return s;
+}
+
+/*************************************************************************
+ * Fills a[0, count) with test strings of testStringShape() for the
+ * indices [first, first + count) of an n key input of the given order.
+ *************************************************************************/
+template <>
+inline void fillTestKeys<std::string>(std::string* a, std::size_t first, std::size_t count, std::size_t n, order type, uint64_t seed)
+{
+	const StringShape shape = testStringShape();
+	const uint64_t key = splitmix64(seed ^ 0x57a1c3e9ULL);
+	const std::size_t threads = std::max<std::size_t>(1, std::min<std::size_t>(testDataConfig().threads ? testDataConfig().threads
+		: std::max(1u, std::thread::hardware_concurrency()), count/FILL_PER_THREAD));
+	std::unique_ptr<uint64_t[]> values(new uint64_t[count]);
+	std::vector<std::string> dictionary;
+
+	fillTestKeys(values.get(), first, count, n, type, seed);
+
+	// Keep the pattern of ordered inputs: value v picks the v-th smallest.
+	if (type != order::RANDOM && type != order::ZIPF && type != order::FEW_UNIQUE)
+	{
+		dictionary.resize(n + 1);
+		forEachThread(threads, [&](std::size_t t) {
+			for (std::size_t v = (n + 1)*t/threads; v < (n + 1)*(t + 1)/threads; v++)
+				dictionary[v] = testString(shape, v, key);
+		});
+		std::sort(dictionary.begin(), dictionary.end());
+	}
+
+	forEachThread(threads, [&](std::size_t t) {
+		for (std::size_t i = count*t/threads; i < count*(t + 1)/threads; i++)
+			a[i] = dictionary.empty() ? testString(shape, values[i], key) : dictionary[std::min<uint64_t>(values[i], n)];
+	});
+}
+
+#endif
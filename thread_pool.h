@@ -0,0 +1,329 @@
+/*************************************************************************
+* Title: Work-Stealing Thread Pool.
+* File: thread_pool.h
+* Date: 10/16/2026
+*
+* Fixed set of worker threads running tasks from per-worker deques
+* (ThreadPool), per-worker load statistics (WorkerStats), and the shared
+* pool used by the parallel sorts (sortPool, configureSortPool).
+*
+* Notes:
+*  (1) A task spawned by a worker goes to the back of that worker's deque
+*      and the worker pops from the back (newest, cache-warm first).  An
+*      idle worker steals from the front of another worker's deque, which
+*      holds the oldest and, in divide and conquer, largest tasks.
+*  (2) run() blocks the calling thread until the root task and all tasks
+*      spawned from it have finished.  Tasks must not call run(); they
+*      spawn instead.
+*  (3) With pinning, worker i is bound to the i-th CPU the process may
+*      run on (Linux sched_getaffinity order).  Elsewhere pinning is
+*      ignored.  The default thread count is the number of such CPUs.
+*  (4) Worker statistics accumulate over runs until resetStats().  The
+*      load imbalance is the busiest worker's busy time over the mean.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Add pools pinned to a given CPU list.
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+// CPUs this process may run on.
+inline std::vector<int> availableCpus()
+{
+	std::vector<int> cpus;
+
+#if defined(__linux__)
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0)
+		for (int c = 0; c < CPU_SETSIZE; c++)
+			if (CPU_ISSET(c, &set))
+				cpus.push_back(c);
+#endif
+	if (cpus.empty())
+		for (unsigned c = 0; c < std::max(1u, std::thread::hardware_concurrency()); c++)
+			cpus.push_back(int(c));
+
+	return cpus;
+}
+
+// Load counters of one worker.
+struct WorkerStats
+{
+	std::size_t tasks = 0;     // Tasks run.
+	std::size_t steals = 0;    // Tasks taken from another worker's deque.
+	std::size_t elements = 0;  // Elements the tasks reported processing.
+	double busyMs = 0.0;       // Time spent running tasks.
+};
+
+class ThreadPool
+{
+public:
+	// Task body, called with the index of the worker running it.
+	typedef std::function<void(unsigned)> Task;
+
+	// Starts threads workers (0 selects one per available CPU), optionally
+	// pinned one per CPU.
+	explicit ThreadPool(unsigned threads = 0, bool pin = false) : pin(pin)
+	{
+		const std::vector<int> cpus = availableCpus();
+
+		start(threads ? threads : unsigned(cpus.size()), cpus);
+	}
+
+	// Starts one worker pinned to each of cpus (e.g. one NUMA node).
+	explicit ThreadPool(const std::vector<int>& cpus) : pin(true)
+	{
+		start(unsigned(cpus.size()), cpus);
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> l(sleepLock);
+			stop = true;
+		}
+		wake.notify_all();
+
+		for (std::unique_ptr<Worker>& w : workers)
+			w->thread.join();
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator= (const ThreadPool&) = delete;
+
+	unsigned size() const { return unsigned(workers.size()); }
+	bool pinned() const { return pin; }
+
+	// Queues task: on the calling worker's deque, or round robin when
+	// called from outside the pool.
+	void spawn(Task task)
+	{
+		const unsigned w = (currentPool() == this) ? currentWorker() : unsigned(next++ % workers.size());
+
+		pending++;
+		{
+			std::lock_guard<std::mutex> l(workers[w]->lock);
+			workers[w]->tasks.push_back(std::move(task));
+		}
+		queued++;
+
+		std::lock_guard<std::mutex> l(sleepLock);
+		wake.notify_one();
+	}
+
+	// Runs root and every task spawned from it, then returns.
+	void run(Task root)
+	{
+		spawn(std::move(root));
+
+		std::unique_lock<std::mutex> l(sleepLock);
+		done.wait(l, [&] { return pending == 0; });
+	}
+
+	// Runs f(i, worker) for i in [0, parts) as separate tasks, then returns.
+	template <typename F>
+	void parallelFor(std::size_t parts, F f)
+	{
+		run([&](unsigned) {
+			for (std::size_t i = 0; i < parts; i++)
+				spawn([&f, i](unsigned w) { f(i, w); });
+		});
+	}
+
+	// Adds to the elements processed by worker w.
+	void addWork(unsigned w, std::size_t elements) { workers[w]->stats.elements += elements; }
+
+	// Per-worker statistics since the last reset (call while idle).
+	std::vector<WorkerStats> stats() const
+	{
+		std::vector<WorkerStats> v;
+
+		for (const std::unique_ptr<Worker>& w : workers)
+			v.push_back(w->stats);
+
+		return v;
+	}
+
+	void resetStats()
+	{
+		for (std::unique_ptr<Worker>& w : workers)
+			w->stats = WorkerStats();
+	}
+
+private:
+	struct Worker
+	{
+		std::mutex lock;         // Guards tasks.
+		std::deque<Task> tasks;  // Own tasks at the back, stolen from the front.
+		WorkerStats stats;       // Written by the worker only.
+		std::thread thread;
+	};
+
+	// Starts threads workers, pinned round robin to cpus if pin is set.
+	void start(unsigned threads, const std::vector<int>& cpus)
+	{
+		for (unsigned i = 0; i < threads; i++)
+			workers.emplace_back(new Worker);
+
+		for (unsigned i = 0; i < threads; i++)
+		{
+			workers[i]->thread = std::thread(&ThreadPool::loop, this, i);
+
+			if (pin)
+				pinThread(workers[i]->thread, cpus[i % cpus.size()]);
+		}
+	}
+
+	static ThreadPool*& currentPool() { thread_local ThreadPool* pool = nullptr; return pool; }
+	static unsigned& currentWorker() { thread_local unsigned worker = 0; return worker; }
+
+	static void pinThread(std::thread& t, int cpu)
+	{
+#if defined(__linux__)
+		cpu_set_t set;
+
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+		(void)t;
+		(void)cpu;
+#endif
+	}
+
+	// Pops the newest task of worker w, or steals the oldest task of
+	// another worker.
+	bool take(unsigned w, Task& task)
+	{
+		{
+			Worker& self = *workers[w];
+			std::lock_guard<std::mutex> l(self.lock);
+
+			if (!self.tasks.empty())
+			{
+				task = std::move(self.tasks.back());
+				self.tasks.pop_back();
+				return true;
+			}
+		}
+
+		for (std::size_t i = 1; i < workers.size(); i++)
+		{
+			Worker& victim = *workers[(w + i) % workers.size()];
+			std::lock_guard<std::mutex> l(victim.lock);
+
+			if (!victim.tasks.empty())
+			{
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				workers[w]->stats.steals++;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Worker w: runs tasks until the pool is destroyed.
+	void loop(unsigned w)
+	{
+		currentPool() = this;
+		currentWorker() = w;
+
+		for (;;)
+		{
+			Task task;
+
+			if (take(w, task))
+			{
+				queued--;
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				task(w);
+				const std::chrono::duration<double, std::milli> busy = std::chrono::steady_clock::now() - start;
+
+				workers[w]->stats.busyMs += busy.count();
+				workers[w]->stats.tasks++;
+
+				if (--pending == 0)
+				{
+					std::lock_guard<std::mutex> l(sleepLock);
+					done.notify_all();
+				}
+
+				continue;
+			}
+
+			std::unique_lock<std::mutex> l(sleepLock);
+			wake.wait(l, [&] { return stop || queued > 0; });
+
+			if (stop && queued == 0)
+				return;
+		}
+	}
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::atomic<std::size_t> pending{ 0 };  // Tasks queued or running.
+	std::atomic<std::size_t> queued{ 0 };   // Tasks waiting in deques.
+	std::atomic<std::size_t> next{ 0 };     // Round robin target of outside spawns.
+	std::mutex sleepLock;                   // Guards sleeping and stop.
+	std::condition_variable wake;           // Signals queued tasks or stop.
+	std::condition_variable done;           // Signals pending reaching zero.
+	bool stop = false;
+	bool pin = false;
+};
+
+// Busiest worker's busy time over the mean busy time, or a negative value
+// when no task ran.
+inline double loadImbalance(const std::vector<WorkerStats>& stats)
+{
+	double total = 0.0, most = 0.0;
+
+	for (const WorkerStats& s : stats)
+	{
+		total += s.busyMs;
+		most = std::max(most, s.busyMs);
+	}
+
+	return (total > 0.0) ? most*stats.size()/total : -1.0;
+}
+
+// Prints one line of load counters per worker.
+inline void reportLoadBalance(std::ostream& os, const std::vector<WorkerStats>& stats)
+{
+	for (std::size_t i = 0; i < stats.size(); i++)
+		os << "  thread " << i << ": " << stats[i].tasks << " tasks, " << stats[i].steals << " steals, "
+			<< stats[i].elements << " elements, " << stats[i].busyMs << "ms busy" << std::endl;
+
+	os << "  load imbalance (max/mean busy): " << loadImbalance(stats) << std::endl;
+}
+
+// Shared pool of the parallel sorts.
+inline std::unique_ptr<ThreadPool>& sortPoolInstance()
+{
+	static std::unique_ptr<ThreadPool> pool;
+
+	return pool;
+}
+
+// Shared pool, started with default settings on first use.
+inline ThreadPool& sortPool()
+{
+	std::unique_ptr<ThreadPool>& pool = sortPoolInstance();
+
+	if (!pool)
+		pool.reset(new ThreadPool());
+
+	return *pool;
+}
+
+// Restarts the shared pool with threads workers (0 for one per CPU).
+inline void configureSortPool(unsigned threads, bool pin)
+{
+	sortPoolInstance().reset(new ThreadPool(threads, pin));
+}
+
+#endif
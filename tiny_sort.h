@@ -0,0 +1,199 @@
+/*************************************************************************
+* Title: Sorting Networks for Tiny Arrays.
+* File: tiny_sort.h
+* Date: 10/16/2026
+*
+* Fixed-size sorts generated at compile time, for arrays of a few keys:
+*   sorting network of N <= 32 keys, fully unrolled (sortingNetwork)
+*   branchless sort of n <= 64 keys (tinySort)
+*   Sort policy: tinySort, or quickSort above 64 keys (networkSort)
+*
+* Notes:
+*  (1) Networks are Batcher's merge exchange (Knuth, TAOCP 5.2.2,
+*      Algorithm M) for any N, built by a constexpr function.  They have
+*      the optimal number of comparators for N <= 8 and are within 8% of
+*      the smallest known networks up to 32 keys (191 against 185), with
+*      comparators in layers that do not depend on each other.
+*  (2) Every comparator index is a compile-time constant, so a network is
+*      straight-line code: no loops, no allocation, and with a plain
+*      comparison of arithmetic keys no branches (each compare-exchange
+*      is one comparison and a pair of conditional moves).
+*  (3) tinySort selects the network for n from a table of N = 0..32.
+*      Between 33 and 64 keys it sorts both halves by network and merges
+*      them branchlessly through a stack buffer (T default constructible).
+*      NETWORK_MAX and TINY_SORT_MAX are defined in sort_funcs.h, whose
+*      kernels call tinySort.
+*  (4) Networks are not stable.  quickSort, radixSort and countingSort
+*      hand ranges of at most their cutoff to tinySort, quickSort only for
+*      comparators of arithmetic keys (cheapCompare).  The radix sorts
+*      order their tiny ranges by radixKey (RadixLess), so floating point
+*      keys keep the IEEE total order of the radix passes, NaN included.
+*************************************************************************
+* Change Log:
+*   10/16/2026: Fix compare-exchange of NaN keys (min/max lost a key).
+*   10/16/2026: Initial release.
+*************************************************************************/
+#ifndef _TINY_SORT_H_
+#define _TINY_SORT_H_
+
+// Comparator of a sorting network: keys i < j are put in order.
+struct NetworkPair
+{
+	uint8_t i, j;
+};
+
+// Visits the comparators of Batcher's merge exchange network for n keys.
+template <typename F>
+constexpr void mergeExchange(std::size_t n, F visit)
+{
+	if (n < 2)
+		return;
+
+	std::size_t t = 0;
+
+	while ((std::size_t(1) << t) < n)
+		t++;
+
+	for (std::size_t p = std::size_t(1) << (t - 1); p > 0; p >>= 1)
+	{
+		std::size_t q = std::size_t(1) << (t - 1), r = 0, d = p;
+
+		for (;;)
+		{
+			for (std::size_t i = 0; i + d < n; i++)
+				if ((i & p) == r)
+					visit(i, i + d);
+
+			if (q == p)
+				break;
+
+			d = q - p;
+			q >>= 1;
+			r = p;
+		}
+	}
+}
+
+// Number of comparators of the network for n keys.
+constexpr std::size_t networkSize(std::size_t n)
+{
+	std::size_t size = 0;
+
+	mergeExchange(n, [&size](std::size_t, std::size_t) { size++; });
+
+	return size;
+}
+
+// Comparators of the network for N keys, in order.
+template <std::size_t N>
+struct SortingNetwork
+{
+	static_assert(N <= NETWORK_MAX, "sorting networks are generated for up to 32 keys");
+
+	static constexpr std::size_t SIZE = networkSize(N);
+
+	static constexpr std::array<NetworkPair, SIZE> pairs()
+	{
+		std::array<NetworkPair, SIZE> net{};
+		std::size_t k = 0;
+
+		mergeExchange(N, [&net, &k](std::size_t i, std::size_t j) { net[k++] = NetworkPair{ uint8_t(i), uint8_t(j) }; });
+
+		return net;
+	}
+
+	static constexpr std::array<NetworkPair, SIZE> PAIRS = pairs();
+};
+
+// Puts a and b in order without a branch.
+template <typename T, typename Compare>
+inline void compareExchange(T& a, T& b, Compare comp)
+{
+	const T x = a, y = b;
+	const bool swap = comp(y, x);
+
+	// Both selects follow one comparison, so a NaN or other unordered pair
+	// is left as it is rather than one key duplicated over the other.
+	a = swap ? y : x;
+	b = swap ? x : y;
+}
+
+template <std::size_t N, typename T, typename Compare, std::size_t... K>
+inline void applyNetwork(T* a, Compare comp, std::index_sequence<K...>)
+{
+	(compareExchange(a[SortingNetwork<N>::PAIRS[K].i], a[SortingNetwork<N>::PAIRS[K].j], comp), ...);
+	(void)a;
+	(void)comp;
+}
+
+/*************************************************************************
+ * Sorts the N keys at a with the unrolled network for N.
+ *************************************************************************/
+template <std::size_t N, typename T, typename Compare>
+void sortingNetwork(T* a, Compare comp)
+{
+	applyNetwork<N>(a, comp, std::make_index_sequence<SortingNetwork<N>::SIZE>());
+}
+
+template <typename T, typename Compare, std::size_t... N>
+inline void networkFor(T* a, std::size_t n, Compare comp, std::index_sequence<N...>)
+{
+	typedef void (*Network)(T*, Compare);
+	static constexpr Network table[] = { &sortingNetwork<N, T, Compare>... };
+
+	table[n](a, comp);
+}
+
+/*************************************************************************
+ * Branchless sort of n <= TINY_SORT_MAX keys.
+ *************************************************************************/
+template <typename T, typename Compare>
+void tinySort(T* begin, T* end, Compare comp)
+{
+	const std::size_t n = std::distance(begin, end);
+
+	if (n <= NETWORK_MAX)
+	{
+		networkFor(begin, n, comp, std::make_index_sequence<NETWORK_MAX + 1>());
+		return;
+	}
+
+	// Sort the halves, then merge them through a buffer.
+	const std::size_t half = n/2;
+	T buffer[TINY_SORT_MAX];
+	const T* a = begin, * aEnd = begin + half, * b = aEnd;
+	T* out = buffer;
+
+	networkFor(begin, half, comp, std::make_index_sequence<NETWORK_MAX + 1>());
+	networkFor(begin + half, n - half, comp, std::make_index_sequence<NETWORK_MAX + 1>());
+
+	while (a != aEnd && b != end)
+	{
+		const bool takeB = comp(*b, *a);
+
+		*out++ = takeB ? *b : *a;
+		b += takeB;
+		a += !takeB;
+	}
+
+	out = std::copy(a, aEnd, out);
+	out = std::copy(b, static_cast<const T*>(end), out);
+	std::copy(buffer, out, begin);
+}
+
+template <typename T>
+void tinySort(T* begin, T* end) { tinySort(begin, end, std::less<T>()); }
+
+/*************************************************************************
+ * Sort policy: tinySort up to TINY_SORT_MAX keys, otherwise quickSort.
+ *************************************************************************/
+template <typename T>
+void networkSort(T* begin, T* end)
+{
+	if (std::size_t(std::distance(begin, end)) <= TINY_SORT_MAX)
+		tinySort(begin, end);
+	else
+		quickSort(begin, end);
+}
+
+#endif